@@ -0,0 +1,121 @@
+#!/usr/bin/env bash
+#
+# parallel.sh
+# Stress test of the interval branching under parallel search and recomputation.
+# - bin/archive (make archive) archives and rebuilds every choice of a walk over the binary and the k-way branching
+#   and compares the domains after committing the original and the rebuilt choice
+# - every configuration of SIZES is run for all solutions with a single thread and then repeatedly with -threads N
+#   (and with adaptive recomputation), the number of solutions must be the same in all runs
+# - LARGE is too big to count all solutions but long enough for the workers to steal work, its first solution must
+#   be a valid packing in every run
+# Exits non-zero if any check fails.
+#
+# usage: ./parallel.sh [threads] [repeats]
+#
+# Environment:
+# TIMEOUT  seconds before a run is killed (default 120), a killed run counts as a failure
+# SIZES    -dimension values to count solutions for (default "2 3 4")
+# LARGE    -dimension value of the first-solution runs (default 12)
+#
+
+THREADS=${1:-8}
+REPEATS=${2:-10}
+TIMEOUT=${TIMEOUT:-120}
+SIZES=${SIZES:-"2 3 4"}
+LARGE=${LARGE:-12}
+BINARY=../square_packing/bin/square_packing_with_overlap_and_interval
+
+cd "$(dirname "$0")"
+if [ ! -x "$BINARY" ]; then
+    echo "$BINARY not built, run make -C ../square_packing" >&2
+    exit 1
+fi
+if [ ! -x bin/archive ]; then
+    echo "bin/archive not built, run make archive" >&2
+    exit 1
+fi
+
+failed=0
+
+bin/archive || failed=1
+
+# Number of solutions of a run with the given arguments, empty if the run failed
+solutions() {
+    timeout "$TIMEOUT" "$BINARY" -mode stat -solutions 0 "$@" 2>&1 |
+        awk '/^[ \t]*solutions:/ { print $2; exit }'
+}
+
+# check <args>, compares the single-threaded solution count with parallel runs
+check() {
+    local expected actual
+    expected=$(solutions -threads 1 "$@")
+    if [ -z "$expected" ]; then
+        echo "FAIL $*: single-threaded run failed"
+        failed=1
+        return
+    fi
+    for ((i = 0; i < REPEATS; i++)); do
+        for mode in "-threads $THREADS" "-threads $THREADS -c_d 8 -a_d 2" "-threads 1 -c_d 8 -a_d 2"; do
+            actual=$(solutions $mode "$@")
+            if [ "$actual" != "$expected" ]; then
+                echo "FAIL $* $mode #$i: ${actual:-no result} solutions, expected $expected"
+                failed=1
+            fi
+        done
+    done
+    echo "ok $*: $expected solutions"
+}
+
+# Whether the first solution of a run with the given arguments is a packing of the squares LARGE..2 into the
+# enclosing square, prints the size of the enclosing square if it is
+packing() {
+    timeout "$TIMEOUT" "$BINARY" -solutions 1 -dimension "$LARGE" "$@" 2>&1 |
+        awk -v n="$LARGE" '
+            /^Enclosing square size:/ { split($4, a, "x"); s = a[1] }
+            /^square[0-9]+: / {
+                for (f = 1; f <= NF; f += 2) {
+                    k = substr($f, 7) + 0
+                    gsub(/[()]/, "", $(f + 1))
+                    split($(f + 1), c, ",")
+                    x[k] = c[1]; y[k] = c[2]; seen++
+                }
+            }
+            END {
+                if (s == "" || seen != n - 1) exit 1
+                for (i = 2; i <= n; i++) {
+                    if (x[i] < 0 || y[i] < 0 || x[i] + i > s || y[i] + i > s) exit 1
+                    for (j = i + 1; j <= n; j++)
+                        if (x[i] < x[j] + j && x[j] < x[i] + i && y[i] < y[j] + j && y[j] < y[i] + i) exit 1
+                }
+                print s
+            }'
+}
+
+# check_large <args>, the first solution of every parallel run must be a valid packing
+check_large() {
+    local s
+    for ((i = 0; i < REPEATS; i++)); do
+        for mode in "-threads $THREADS" "-threads $THREADS -c_d 8 -a_d 2"; do
+            s=$(packing $mode "$@")
+            if [ -z "$s" ]; then
+                echo "FAIL -dimension $LARGE $* $mode #$i: no valid packing"
+                failed=1
+            fi
+        done
+    done
+    echo "ok -dimension $LARGE $*: valid packings"
+}
+
+check_large
+check_large -alternatives 4 -shrink 0.9
+
+for size in $SIZES; do
+    check -dimension "$size"
+    check -dimension "$size" -propagation sweep
+    check -dimension "$size" -propagation square
+    check -dimension "$size" -branching afc
+    check -dimension "$size" -branching activity
+    check -dimension "$size" -alternatives 3 -shrink 0.9
+done
+
+exit $failed
@@ -0,0 +1,125 @@
+#!/usr/bin/env bash
+#
+# run.sh
+# Runs every model over a grid of sizes and -ipl values with -mode stat and collects the statistics
+# (runtime, nodes, failures, propagations, peak depth, peak memory) in results.csv and results.json.
+#
+# usage: ./run.sh [repeats] [outdir]
+#
+# Environment:
+# TIMEOUT  seconds before a run is killed (default 60), the run is recorded with status timeout
+# IPLS     -ipl values to run (default "def speed dom")
+# TIME     GNU time used for the max resident set size (default /usr/bin/time, skipped if missing)
+#
+
+REPEATS=${1:-5}
+OUTDIR=${2:-results}
+TIMEOUT=${TIMEOUT:-60}
+IPLS=${IPLS:-"def speed dom"}
+TIME=${TIME:-/usr/bin/time}
+
+cd "$(dirname "$0")"
+mkdir -p "$OUTDIR"
+CSV="$OUTDIR/results.csv"
+JSON="$OUTDIR/results.json"
+STAT=$(mktemp)
+RSS=$(mktemp)
+trap 'rm -f "$STAT" "$RSS"' EXIT
+
+echo "model,args,size,ipl,iteration,status,runtime_ms,solutions,propagations,nodes,failures,peak_depth,peak_memory_kb,max_rss_kb" > "$CSV"
+
+# Value of a "key: value" line of the -mode stat output, runtime is taken in ms from "runtime: 1.2 (1234.5 ms)"
+stat() {
+    awk -v key="$1" '
+        $0 ~ "^[ \t]*" key ":" {
+            sub("^[ \t]*" key ":[ \t]*", "")
+            if (key == "runtime") { sub(/.*\(/, ""); sub(/ ms\).*/, "") }
+            sub(/ .*/, "")
+            print
+            exit
+        }' "$STAT"
+}
+
+# bench <model> <binary> <sizes> <args>, SIZE in args is replaced by each size
+bench() {
+    local model=$1 binary=$2 sizes=$3 args=$4
+    if [ ! -x "$binary" ]; then
+        echo "skipping $model, $binary not built" >&2
+        return
+    fi
+    for size in $sizes; do
+        for ipl in $IPLS; do
+            for ((i = 0; i < REPEATS; i++)); do
+                local status=ok rc
+                if [ -x "$TIME" ]; then
+                    timeout "$TIMEOUT" "$TIME" -f "%M" -o "$RSS" \
+                        "$binary" -mode stat -ipl "$ipl" ${args//SIZE/$size} > "$STAT" 2>&1
+                    rc=$?
+                else
+                    timeout "$TIMEOUT" "$binary" -mode stat -ipl "$ipl" ${args//SIZE/$size} > "$STAT" 2>&1
+                    rc=$?
+                    : > "$RSS"
+                fi
+                case $rc in
+                    0) ;;
+                    124) status=timeout ;;
+                    *) status=error ;;
+                esac
+                printf '%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s\n' "$model" "${args//SIZE/$size}" "$size" "$ipl" "$i" \
+                    "$status" "$(stat runtime)" "$(stat solutions)" "$(stat propagations)" "$(stat nodes)" \
+                    "$(stat failures)" "$(stat 'peak depth')" "$(stat 'peak memory')" \
+                    "$(tail -n 1 "$RSS" | tr -dc 0-9)" >> "$CSV"
+                echo "$model $size -ipl $ipl #$i: $status"
+            done
+        done
+    done
+}
+
+bench queens ../n_queens/bin/queens "8 10 12" "-solutions 0 SIZE"
+bench magic_sequence ../magic_sequence/bin/magic_sequence "50 100 200" "-solutions 0 SIZE"
+bench magic_sequence_with_prop ../magic_sequence/bin/magic_sequence_with_prop "50 100 200" "-solutions 0 SIZE"
+bench square ../square_packing/bin/square "10 14 18" "-solutions 1 SIZE"
+bench square_packing_with_overlap ../square_packing/bin/square_packing_with_overlap "10 14 18" "-solutions 1 SIZE"
+bench square_packing_with_overlap_and_interval ../square_packing/bin/square_packing_with_overlap_and_interval \
+    "10 14 18" "-solutions 1 -dimension SIZE"
+# variable selection of the coordinate (and interval) branchings for n=15..30
+for branching in size afc activity; do
+    bench square_$branching ../square_packing/bin/square "15 20 25 30" "-solutions 1 -branching $branching SIZE"
+    bench square_packing_with_overlap_and_interval_$branching \
+        ../square_packing/bin/square_packing_with_overlap_and_interval "15 20 25 30" \
+        "-solutions 1 -branching $branching -dimension SIZE"
+done
+# k-way interval branching with an obligatory part that shrinks with depth and failures
+bench square_packing_with_overlap_and_interval_adaptive ../square_packing/bin/square_packing_with_overlap_and_interval \
+    "20 25 30" "-solutions 1 -alternatives 4 -shrink 0.9 -dimension SIZE"
+bench life ../game_of_life/bin/life "6 7 8" "SIZE"
+bench life_reified ../game_of_life/bin/life "6 7 8" "-propagation reified SIZE"
+bench life_board ../game_of_life/bin/life "6 7 8" "-propagation board SIZE"
+bench life_plain ../game_of_life/bin/life "6 7 8" "-model plain SIZE"
+# symmetry breaking over the rotations and reflections of the board for n=8..14 (nodes of none vs lex and ldsb)
+for symmetry in none lex ldsb; do
+    bench life_symmetry_$symmetry ../game_of_life/bin/life "8 9 10 11 12 13 14" "-symmetry $symmetry SIZE"
+done
+bench golomb_rulers ../golomb_rulers/bin/golomb_rulers "8 9 10" "SIZE"
+# workers sharing the best cost, the totals over all workers are recorded
+bench life_parallel ../game_of_life/bin/life "8 9 10" "-search parallel -threads 8 SIZE"
+bench golomb_rulers_parallel ../golomb_rulers/bin/golomb_rulers "10 11 12" "-search parallel -threads 8 SIZE"
+bench sudoku ../sudoku/bin/sudoku "0 4 9 17" "-sudoku SIZE"
+bench sudoku_order4 ../sudoku/bin/sudoku "4" "-order SIZE -propagation bitset"
+
+# results.json, one object per row of results.csv, numbers are left unquoted
+awk -F, '
+    NR == 1 { n = split($0, key, ","); print "["; next }
+    {
+        printf "%s  {", (NR > 2 ? ",\n" : "")
+        for (k = 1; k <= n; k++) {
+            v = $k
+            if (v == "") v = "null"
+            else if (v !~ /^-?[0-9.]+$/) v = "\"" v "\""
+            printf "%s\"%s\": %s", (k > 1 ? ", " : ""), key[k], v
+        }
+        printf "}"
+    }
+    END { print "\n]" }' "$CSV" > "$JSON"
+
+echo "wrote $CSV and $JSON"
@@ -0,0 +1,153 @@
+//
+// archive.cpp
+// Round trip of the interval branching's choices through an Archive. The parallel search engines only archive and
+// rebuild choices when a worker steals work, which small instances hardly ever do, so every choice of a depth-first
+// walk is checked here: the choice is archived, rebuilt with Space::choice(Archive&), and every alternative is
+// committed on clones of the space with the original and with the rebuilt choice. The domains after propagation
+// must be the same.
+//
+// usage: ./bin/archive [n] [choices]
+// Packs the squares n..2 (as square_packing_with_overlap_and_interval), checks at most choices choices per variant.
+// Exits non-zero if any choice does not survive the round trip.
+//
+
+#include <gecode/int.hh>
+#include <gecode/search.hh>
+#include "../../common/interval.hh"
+#include "../../common/no-overlap.hh"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+using namespace Gecode;
+
+/**
+ * The squares n..2 in an s x s square with interval branching on the x- and then the y-coordinates.
+ */
+class Packing : public Space {
+public:
+    IntVarArray x, y;
+
+    Packing(int n, int s, int k, double shrink) : x(*this, n - 1, 0, s), y(*this, n - 1, 0, s) {
+        IntArgs w(n - 1);
+        for (int i = 0; i < n - 1; ++i) {
+            w[i] = n - i;
+            rel(*this, x[i], IRT_LQ, s - w[i]);
+            rel(*this, y[i], IRT_LQ, s - w[i]);
+        }
+        nooverlap(*this, x, w, y, w);
+        interval(*this, x, w, 0.35, INTERVAL_FIRST, 1.0, k, shrink);
+        interval(*this, y, w, 0.35, INTERVAL_FIRST, 1.0, k, shrink);
+    }
+
+    /// Constructor for cloning
+    Packing(bool share, Packing &p) : Space(share, p) {
+        x.update(*this, share, p.x);
+        y.update(*this, share, p.y);
+    }
+
+    /// Perform copying during cloning
+    virtual Space *copy(bool share) {
+        return new Packing(share, *this);
+    }
+};
+
+/**
+ * Whether the domains of a and b are the same after propagation.
+ *
+ * @param a
+ * @param b
+ * @return
+ */
+bool same(Packing &a, Packing &b) {
+    SpaceStatus sa = a.status();
+    SpaceStatus sb = b.status();
+    if (sa != sb)
+        return false;
+    if (sa == SS_FAILED)
+        return true;
+    for (int i = 0; i < a.x.size(); ++i) {
+        if (a.x[i].size() != b.x[i].size() || a.y[i].size() != b.y[i].size())
+            return false;
+        for (int v = a.x[i].min(); v <= a.x[i].max(); ++v)
+            if (a.x[i].in(v) != b.x[i].in(v))
+                return false;
+        for (int v = a.y[i].min(); v <= a.y[i].max(); ++v)
+            if (a.y[i].in(v) != b.y[i].in(v))
+                return false;
+    }
+    return true;
+}
+
+/**
+ * Depth-first walk from home that checks the round trip of every choice, takes ownership of home.
+ *
+ * @param home
+ * @param choices number of choices checked so far
+ * @param limit maximal number of choices
+ * @param mismatches number of choices that did not survive the round trip
+ */
+void walk(Packing *home, unsigned long int &choices, unsigned long int limit, unsigned long int &mismatches) {
+    if (choices >= limit || home->status() != SS_BRANCH) {
+        delete home;
+        return;
+    }
+    choices++;
+    const Choice *choice = home->choice();
+    Archive archive;
+    choice->archive(archive);
+    const Choice *rebuilt = home->choice(archive);
+    if (rebuilt->alternatives() != choice->alternatives()) {
+        mismatches++;
+    } else {
+        for (unsigned int a = 0; a < choice->alternatives(); ++a) {
+            Packing *original = static_cast<Packing *>(home->clone(false));
+            Packing *restored = static_cast<Packing *>(home->clone(false));
+            original->commit(*choice, a);
+            restored->commit(*rebuilt, a);
+            if (!same(*original, *restored))
+                mismatches++;
+            delete original;
+            delete restored;
+        }
+    }
+    for (unsigned int a = 0; a < choice->alternatives(); ++a) {
+        Packing *child = (a + 1 < choice->alternatives()) ? static_cast<Packing *>(home->clone(false)) : home;
+        child->commit(*choice, a);
+        walk(child, choices, limit, mismatches);
+    }
+    delete choice;
+    delete rebuilt;
+}
+
+/**
+ * Checks the binary and the k-way interval branching.
+ * @param argc
+ * @param argv
+ * @return
+ */
+int main(int argc, char *argv[]) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 8;
+    unsigned long int limit = argc > 2 ? std::strtoul(argv[2], NULL, 10) : 5000;
+    if (n < 3) {
+        std::cerr << "n must be at least 3" << std::endl;
+        return 1;
+    }
+    //Smallest enclosing square by area plus one, tight enough for failures and deep enough for every alternative
+    int s = static_cast<int>(std::ceil(std::sqrt(n * (n + 1) * (2 * n + 1) / 6.0))) + 1;
+
+    const int k[] = {2, 4};
+    const double shrink[] = {1.0, 0.9};
+    int failed = 0;
+    for (int v = 0; v < 2; ++v) {
+        unsigned long int choices = 0, mismatches = 0;
+        walk(new Packing(n, s, k[v], shrink[v]), choices, limit, mismatches);
+        //A walk without choices would pass without checking anything
+        bool ok = choices > 0 && mismatches == 0;
+        std::cout << (ok ? "ok" : "FAIL") << " archive -alternatives " << k[v] << " -shrink " << shrink[v] << ": "
+                  << choices << " choices, " << mismatches << " mismatches" << std::endl;
+        if (!ok)
+            failed = 1;
+    }
+    return failed;
+}
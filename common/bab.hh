@@ -0,0 +1,202 @@
+//
+// bab.hh
+// Parallel branch-and-bound where the workers share the best cost found so far.
+//
+
+#ifndef COMMON_BAB_HH
+#define COMMON_BAB_HH
+
+#include <gecode/int.hh>
+#include <gecode/search.hh>
+#include "options.hh"
+#include <atomic>
+#include <climits>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace Gecode;
+
+/**
+ * Best cost found by any worker. The cost only ever improves, updates are a compare-and-swap loop so that the
+ * workers never wait on each other to publish or to read the bound.
+ */
+class SharedBound {
+private:
+    std::atomic<int> best;
+    const bool min;
+public:
+    // Bound of a minimization (or maximization) problem, no cost found yet
+    SharedBound(bool minimize) : best(minimize ? INT_MAX : INT_MIN), min(minimize) {}
+
+    // Whether the problem is minimized
+    bool minimize(void) const {
+        return min;
+    }
+
+    // Whether a cost has been found
+    bool set(void) const {
+        return best.load() != (min ? INT_MAX : INT_MIN);
+    }
+
+    // The best cost found so far
+    int value(void) const {
+        return best.load();
+    }
+
+    /**
+     * Publish cost v, keeps the bound if it is at least as good as v.
+     *
+     * @param v
+     * @return whether v is the new bound
+     */
+    bool improve(int v) {
+        int b = best.load();
+        while (min ? v < b : v > b)
+            if (best.compare_exchange_weak(b, v))
+                return true;
+        return false;
+    }
+};
+
+/**
+ * Search statistics of one worker.
+ */
+class WorkerStatistics {
+public:
+    // Number of subproblems taken from the frontier
+    unsigned long int subproblems;
+    // Number of solutions found
+    unsigned long int solutions;
+    // Runtime in ms
+    double time;
+    // Statistics of the BAB engines
+    Search::Statistics search;
+
+    WorkerStatistics(void) : subproblems(0), solutions(0), time(0) {}
+};
+
+/**
+ * Parallel branch-and-bound. The root is expanded breadth-first into a frontier of subproblems (a few per worker),
+ * the workers pull subproblems from the frontier and solve each with a sequential BAB engine. Every solution is
+ * published in the shared bound: a subproblem is constrained by the bound before its search starts, and a running
+ * search picks up new bounds at its next constrain, which BAB calls for the nodes after each of its own solutions.
+ * At the end the best solution and the statistics of every worker are printed.
+ *
+ * The model is constructed with the commandline options and the shared bound, provides cost() and also constrains the
+ * cost by the shared bound in constrain. The engines do not recompute (c_d = 1): a path replayed after another worker
+ * improved the bound would prune differently than the original descent.
+ *
+ * @param opt commandline options, -threads is the number of workers
+ * @param minimize whether the cost is minimized (or maximized)
+ */
+template<class Model, class Opt>
+void parallelbab(const Opt &opt, bool minimize) {
+    Support::Timer timer;
+    timer.start();
+    SharedBound bound(minimize);
+    const unsigned int workers = threads(opt);
+
+    //Expand the root into at least 4 subproblems per worker
+    std::deque<Space *> open;
+    std::vector<Model *> frontier;
+    open.push_back(new Model(opt, &bound));
+    while (!open.empty() && open.size() + frontier.size() < 4 * workers) {
+        Space *s = open.front();
+        open.pop_front();
+        switch (s->status()) {
+            case SS_FAILED:
+                delete s;
+                break;
+            case SS_SOLVED:
+                frontier.push_back(static_cast<Model *>(s));
+                break;
+            case SS_BRANCH: {
+                const Choice *ch = s->choice();
+                for (unsigned int a = 0; a < ch->alternatives(); ++a) {
+                    Space *c = (a + 1 < ch->alternatives()) ? s->clone(false) : s;
+                    c->commit(*ch, a);
+                    open.push_back(c);
+                }
+                delete ch;
+                break;
+            }
+        }
+    }
+    for (unsigned int i = 0; i < open.size(); ++i)
+        frontier.push_back(static_cast<Model *>(open[i]));
+
+    std::atomic<unsigned int> next(0);
+    std::mutex mutex;
+    Model *solution = NULL;
+    std::vector<WorkerStatistics> statistics(workers);
+    std::vector<std::thread> pool;
+    for (unsigned int w = 0; w < workers; ++w) {
+        pool.push_back(std::thread([&, w]() {
+            WorkerStatistics &ws = statistics[w];
+            Support::Timer t;
+            t.start();
+            for (unsigned int i = next++; i < frontier.size(); i = next++) {
+                Model *subproblem = frontier[i];
+                ws.subproblems++;
+                //A subproblem started late is pruned by everything found so far
+                if (bound.set())
+                    rel(*subproblem, subproblem->cost(), minimize ? IRT_LE : IRT_GR, bound.value());
+                Search::Options so = searchOptions(opt);
+                so.threads = 1;
+                so.c_d = 1;
+                so.clone = false;
+                BAB<Model> e(subproblem, so);
+                while (Model *s = e.next()) {
+                    ws.solutions++;
+                    if (!bound.improve(s->cost().val())) {
+                        delete s;
+                        continue;
+                    }
+                    std::lock_guard<std::mutex> lock(mutex);
+                    //Another worker can have published a better cost between improve and lock
+                    if (solution == NULL || (minimize ? s->cost().val() < solution->cost().val()
+                                                      : s->cost().val() > solution->cost().val())) {
+                        delete solution;
+                        solution = s;
+                        std::cout << "Worker " << w << ": cost " << s->cost().val() << std::endl;
+                    } else {
+                        delete s;
+                    }
+                }
+                ws.search += e.statistics();
+            }
+            ws.time = t.stop();
+        }));
+    }
+    for (unsigned int w = 0; w < pool.size(); ++w)
+        pool[w].join();
+    double time = timer.stop();
+
+    if (solution == NULL)
+        std::cout << "No solution found" << std::endl;
+    else
+        solution->print(std::cout);
+    //The totals come first, benchmark/run.sh reads the first runtime, nodes and failures
+    Search::Statistics total;
+    for (unsigned int w = 0; w < workers; ++w)
+        total += statistics[w].search;
+    std::cout << "Total: " << frontier.size() << " subproblems" << std::endl
+              << "\truntime:      " << time << " ms" << std::endl
+              << "\tnodes:        " << total.node << std::endl
+              << "\tfailures:     " << total.fail << std::endl;
+    for (unsigned int w = 0; w < workers; ++w) {
+        const WorkerStatistics &ws = statistics[w];
+        std::cout << "Worker " << w << ": " << ws.subproblems << " subproblems, " << ws.solutions << " solutions"
+                  << std::endl
+                  << "\truntime:      " << ws.time << " ms" << std::endl
+                  << "\tnodes:        " << ws.search.node << std::endl
+                  << "\tfailures:     " << ws.search.fail << std::endl
+                  << "\tpeak depth:   " << ws.search.depth << std::endl;
+    }
+    delete solution;
+}
+
+#endif
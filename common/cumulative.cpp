@@ -0,0 +1,27 @@
+//
+// cumulative.cpp
+// Post function and instantiations of the cumulative propagator.
+//
+
+#include "cumulative.hh"
+
+template class Cumulative<IntView>;
+template class Cumulative<OffsetView>;
+template class Cumulative<MinusView>;
+
+void squarecumulative(Space &home, const IntVarArgs &x, const IntArgs &w, IntVar c) {
+    // Check whether the arguments make sense
+    if (x.size() != w.size())
+        throw ArgumentSizeMismatch("squarecumulative");
+    // Never post a propagator in a failed space
+    if (home.failed()) return;
+    // Set up array of views for the coordinates
+    ViewArray<IntView> vx(home, x);
+    // Set up array (allocated in home) for the sizes and initialize
+    int *wc = static_cast<Space &>(home).alloc<int>(x.size());
+    for (int i = x.size(); i--;)
+        wc[i] = w[i];
+    // If posting failed, fail space
+    if (Cumulative<IntView>::post(home, vx, wc, IntView(c)) != ES_OK)
+        home.fail();
+}
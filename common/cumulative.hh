@@ -0,0 +1,237 @@
+//
+// cumulative.hh
+// Cumulative propagator for squares, templated over the view type of the coordinates.
+//
+
+#ifndef COMMON_CUMULATIVE_HH
+#define COMMON_CUMULATIVE_HH
+
+#include <gecode/int.hh>
+
+using namespace Gecode;
+using namespace Gecode::Int;
+
+// The cumulative propagator for squares
+// Enforces that the sizes of the squares occupying any column (or row) sum up to at most the size of the enclosing
+// square. Replaces the decomposition with one reified dom-constraint per square and column index, the propagator only
+// keeps the coordinates and the sizes, i.e O(n) state instead of O(n*s) Boolean variables.
+// Propagation is timetabling on the compulsory parts, plus an energetic overload check once the timetable is at its
+// fix-point.
+// The coordinates are views of type View, the capacity is an IntView.
+template<class View>
+class Cumulative : public Propagator {
+protected:
+    // The coordinates (x or y)
+    ViewArray<View> x;
+    // The sizes (width = height for squares)
+    int *w;
+    // The capacity (size of the enclosing square)
+    IntView c;
+
+    // Start or end of a compulsory part
+    class Event {
+    public:
+        // Coordinate of the event
+        int pos;
+        // Change of the occupied size at pos
+        int delta;
+    };
+
+    // Sort order of events
+    class EventLess {
+    public:
+        bool operator()(const Event &a, const Event &b) const {
+            return a.pos < b.pos;
+        }
+    };
+
+    // Segment [start, end) of the profile with constant occupied size
+    class Segment {
+    public:
+        int start, end, height;
+    };
+
+    // Minimal overlap of square i with the interval [a, b) no matter its placement
+    int minOverlap(int i, int a, int b) const {
+        int o = std::min(std::min(b - a, w[i]), std::min(x[i].min() + w[i] - a, b - x[i].max()));
+        return std::max(o, 0);
+    }
+
+    // Energetic reasoning: the squares must fit into any interval [a, b) where a is an earliest start and b a latest
+    // end of a square.
+    ExecStatus energetic(Space &home, bool &modified) {
+        for (int i = 0; i < x.size(); ++i) {
+            int a = x[i].min();
+            for (int j = 0; j < x.size(); ++j) {
+                int b = x[j].max() + w[j];
+                if (b <= a)
+                    continue;
+                long long energy = 0;
+                for (int k = 0; k < x.size(); ++k)
+                    energy += static_cast<long long>(w[k]) * minOverlap(k, a, b);
+                if (energy > static_cast<long long>(c.max()) * (b - a))
+                    return ES_FAILED;
+                ModEvent me = c.gq(home, static_cast<int>((energy + (b - a) - 1) / (b - a)));
+                GECODE_ME_CHECK(me);
+                modified |= me_modified(me);
+            }
+        }
+        return ES_OK;
+    }
+
+public:
+    // Create propagator and initialize
+    Cumulative(Home home, ViewArray<View> &x0, int w0[], IntView c0) :
+            Propagator(home),
+            x(x0),
+            w(w0),
+            c(c0) {
+        x.subscribe(home, *this, PC_INT_BND);
+        c.subscribe(home, *this, PC_INT_BND);
+    }
+
+    // Post cumulative propagator
+    static ExecStatus post(Home home, ViewArray<View> &x, int w[], IntView c) {
+        (void) new(home) Cumulative(home, x, w, c);
+        return ES_OK;
+    }
+
+    // Copy constructor during cloning
+    Cumulative(Space &home, bool share, Cumulative &p)
+            : Propagator(home, share, p) {
+        x.update(home, share, p.x);
+        c.update(home, share, p.c);
+        // Also copy the sizes
+        w = home.alloc<int>(x.size());
+        for (int i = x.size(); i--;)
+            w[i] = p.w[i];
+    }
+
+    // Create copy during cloning
+    virtual Propagator *copy(Space &home, bool share) {
+        return new(home) Cumulative(home, share, *this);
+    }
+
+    // Re-schedule function after propagator has been re-enabled
+    virtual void reschedule(Space &home) {
+        x.reschedule(home, *this, PC_INT_BND);
+        c.reschedule(home, *this, PC_INT_BND);
+    }
+
+    // Return cost (the energetic reasoning is cubic)
+    virtual PropCost cost(const Space &, const ModEventDelta &) const {
+        return PropCost::cubic(PropCost::LO, x.size());
+    }
+
+    // Perform propagation
+    virtual ExecStatus propagate(Space &home, const ModEventDelta &) {
+        Region r(home);
+        bool modified = false;
+        int n = x.size();
+
+        /**
+         * Compulsory part of each square, [x.max, x.min + w) is occupied no matter the placement.
+         */
+        int *cpStart = r.alloc<int>(n);
+        int *cpEnd = r.alloc<int>(n);
+        Event *events = r.alloc<Event>(2 * n);
+        int nEvents = 0;
+        for (int i = 0; i < n; ++i) {
+            cpStart[i] = x[i].max();
+            cpEnd[i] = x[i].min() + w[i];
+            if (cpStart[i] < cpEnd[i]) {
+                events[nEvents].pos = cpStart[i];
+                events[nEvents++].delta = w[i];
+                events[nEvents].pos = cpEnd[i];
+                events[nEvents++].delta = -w[i];
+            }
+        }
+        EventLess less;
+        Support::quicksort<Event, EventLess>(events, nEvents, less);
+
+        /**
+         * Timetable, profile of the occupied size per column.
+         * The enclosing square must be at least as big as the highest column.
+         */
+        Segment *profile = r.alloc<Segment>(nEvents);
+        int nSegments = 0;
+        int height = 0;
+        for (int k = 0; k < nEvents; ++k) {
+            if (k > 0 && events[k].pos > events[k - 1].pos && height > 0) {
+                profile[nSegments].start = events[k - 1].pos;
+                profile[nSegments].end = events[k].pos;
+                profile[nSegments++].height = height;
+                ModEvent me = c.gq(home, height);
+                GECODE_ME_CHECK(me);
+                modified |= me_modified(me);
+            }
+            height += events[k].delta;
+        }
+
+        /**
+         * Squares can not be placed over a segment where they would exceed the capacity.
+         * Segments are split at every compulsory part boundary, so a segment is either inside or outside the
+         * compulsory part of a square.
+         */
+        for (int i = 0; i < n; ++i) {
+            if (x[i].assigned())
+                continue;
+            int lb = x[i].min();
+            for (int k = 0; k < nSegments && profile[k].start < lb + w[i]; ++k) {
+                if (profile[k].end <= lb)
+                    continue;
+                int own = (profile[k].start >= cpStart[i] && profile[k].end <= cpEnd[i]) ? w[i] : 0;
+                if (profile[k].height - own + w[i] > c.max())
+                    lb = profile[k].end;
+            }
+            int ub = x[i].max();
+            for (int k = nSegments; k-- && profile[k].end > ub;) {
+                if (profile[k].start >= ub + w[i])
+                    continue;
+                int own = (profile[k].start >= cpStart[i] && profile[k].end <= cpEnd[i]) ? w[i] : 0;
+                if (profile[k].height - own + w[i] > c.max())
+                    ub = profile[k].start - w[i];
+            }
+            ModEvent me = x[i].gq(home, lb);
+            GECODE_ME_CHECK(me);
+            modified |= me_modified(me);
+            me = x[i].lq(home, ub);
+            GECODE_ME_CHECK(me);
+            modified |= me_modified(me);
+        }
+
+        if (modified)
+            return ES_NOFIX; //Compulsory parts might have grown, run again.
+
+        //The cubic energetic check only runs once the timetable is at its fix-point
+        GECODE_ES_CHECK(energetic(home, modified));
+        if (modified)
+            return ES_NOFIX;
+        if (x.assigned())
+            return home.ES_SUBSUMED(*this); //Profile is fixed and the capacity covers it.
+        return ES_FIX;
+    }
+
+    // Dispose propagator and return its size
+    virtual size_t dispose(Space &home) {
+        x.cancel(home, *this, PC_INT_BND);
+        c.cancel(home, *this, PC_INT_BND);
+        (void) Propagator::dispose(home);
+        return sizeof(*this);
+    }
+};
+
+/*
+ * Post the constraint that for every column the sizes of the squares with coordinates x and sizes w that occupy it
+ * sum up to at most c. Post it on the y-coordinates for the rows.
+ *
+ * This is the function that you will call from your model, include this header and link the common library.
+ */
+void squarecumulative(Space &home, const IntVarArgs &x, const IntArgs &w, IntVar c);
+
+// The propagators for the views below are compiled into the common library
+extern template class Cumulative<IntView>;
+extern template class Cumulative<OffsetView>;
+extern template class Cumulative<MinusView>;
+
+#endif
@@ -0,0 +1,37 @@
+//
+// interval.cpp
+// Post function and instantiations of the interval branching.
+//
+
+#include "interval.hh"
+
+template class IntervalBrancher<IntView>;
+template class IntervalBrancher<OffsetView>;
+template class IntervalBrancher<MinusView>;
+
+void interval(Home home, const IntVarArgs &x, const IntArgs &w, double p,
+              IntervalSelect select, double decay, int k, double shrink) {
+    // Check whether arguments make sense
+    if (k < 2 || shrink <= 0.0 || shrink > 1.0)
+        throw OutOfLimits("interval");
+    // Check whether arguments make sense
+    if (x.size() != w.size())
+        throw ArgumentSizeMismatch("interval");
+    // Never post a branching in a failed space
+    if (home.failed()) return;
+    // Create an array of integer views
+    ViewArray<IntView> vx(home, x);
+    // Create an array of integers
+    int *wc = static_cast<Space &>(home).alloc<int>(x.size());
+    for (int i = x.size(); i--;)
+        wc[i] = w[i];
+    // AFC is kept by the space for all variables, the decay applies to it as a whole
+    if (select == INTERVAL_AFC) {
+        IntAFC afc(home, x, decay);
+    }
+    IntActivity activity;
+    if (select == INTERVAL_ACTIVITY)
+        activity = IntActivity(home, x, decay);
+    // Post the brancher
+    IntervalBrancher<IntView>::post(home, vx, wc, p, select, activity, k, shrink);
+}
@@ -0,0 +1,268 @@
+/*
+ *  Main authors:
+ *     Christian Schulte <cschulte@kth.se>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2009
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+//
+// interval.hh
+// Interval branching forcing obligatory parts of rectangles, templated over the view type of the coordinates.
+//
+
+#ifndef COMMON_INTERVAL_HH
+#define COMMON_INTERVAL_HH
+
+#include <gecode/int.hh>
+#include <cmath>
+
+using namespace Gecode;
+using namespace Gecode::Int;
+
+// Selection of the rectangle to branch on
+enum IntervalSelect {
+    INTERVAL_FIRST,   //first rectangle with room for an obligatory part
+    INTERVAL_AFC,     //rectangle with the largest accumulated failure count
+    INTERVAL_ACTIVITY //rectangle with the largest activity
+};
+
+/*
+ * Custom brancher for forcing mandatory parts
+ * A good percentage value for p is 0.35, this have been verified with experiements but was first found in this paper:
+ * https://www.ijcai.org/Proceedings/09/Papers/092.pdf
+ */
+template<class View>
+class IntervalBrancher : public Brancher {
+protected:
+    // Views for x-coordinates (or y-coordinates)
+    ViewArray<View> x;
+    // Width (or height) of rectangles
+    int *w;
+    // Percentage for obligatory part
+    double p;
+    // Cache of first unassigned view
+    mutable int start;
+    // Selection of the rectangle
+    IntervalSelect select;
+    // Activity of the views, only with INTERVAL_ACTIVITY
+    IntActivity activity;
+    // Maximal number of alternatives (intervals) per choice
+    int k;
+    // Factor p is multiplied with per level
+    double shrink;
+    // Level of the brancher, the number of commits plus the number of alternatives skipped by them (a failed or
+    // exhausted left sibling) on the path from the root
+    unsigned int level;
+
+    // Percentage for the obligatory part at the current level
+    double obligatory(void) const {
+        return p * std::pow(shrink, static_cast<double>(level));
+    }
+
+    // Rectangle i is unassigned and its range has space for an obligatory part of size p*size
+    bool branchable(int i) const {
+        return !x[i].assigned() && (x[i].min() + w[i] - std::ceil(obligatory() * w[i])) < x[i].max();
+    }
+
+    // Conflict weight of rectangle i
+    double weight(const Space &home, int i) const {
+        return select == INTERVAL_AFC ? x[i].afc(home) : activity[i];
+    }
+
+    // Description, alternative i is the interval [lo + i*len, lo + (i+1)*len - 1], the last one is open ended
+    class Description : public Choice {
+    public:
+        // Position of view
+        int pos;
+        // Start of the first interval
+        int lo;
+        // Length of the intervals
+        int len;
+
+        /* Initialize description for brancher b, number of
+         *  alternatives a, position p, first interval start lo and interval length len.
+         */
+        Description(const Brancher &b, unsigned int a, int p, int lo, int len)
+                : Choice(b, a), pos(p), lo(lo), len(len) {}
+
+        // Report size occupied
+        virtual size_t size(void) const {
+            return sizeof(Description);
+        }
+
+        // Archive the choice's information in e
+        virtual void archive(Archive &e) const {
+            Choice::archive(e);
+            // You must also archive the additional information
+            e << alternatives() << pos << lo << len;
+        }
+    };
+
+public:
+    // Construct branching
+    IntervalBrancher(Home home,
+                     ViewArray<View> &x0, int w0[], double p0, IntervalSelect select0, IntActivity &activity0,
+                     int k0, double shrink0)
+            : Brancher(home), x(x0), w(w0), p(p0), start(0), select(select0), activity(activity0),
+              k(k0), shrink(shrink0), level(0) {
+        // The activity must be released when the brancher is disposed
+        if (select == INTERVAL_ACTIVITY)
+            home.notice(*this, AP_DISPOSE);
+    }
+
+    // Post branching
+    static void post(Home home, ViewArray<View> &x, int w[], double p,
+                     IntervalSelect select, IntActivity &activity, int k, double shrink) {
+        (void) new(home) IntervalBrancher(home, x, w, p, select, activity, k, shrink);
+    }
+
+    // Copy constructor used during cloning of b
+    IntervalBrancher(Space &home, bool share, IntervalBrancher &b)
+            : Brancher(home, share, b), p(b.p), start(b.start), select(b.select),
+              k(b.k), shrink(b.shrink), level(b.level) {
+        x.update(home, share, b.x);
+        if (select == INTERVAL_ACTIVITY)
+            activity.update(home, share, b.activity);
+        w = home.alloc<int>(x.size());
+        for (int i = x.size(); i--;)
+            w[i] = b.w[i];
+    }
+
+    // Copy brancher
+    virtual Actor *copy(Space &home, bool share) {
+        return new(home) IntervalBrancher(home, share, *this);
+    }
+
+    // Check status of brancher, return true if alternatives left
+    virtual bool status(const Space &home) const {
+        for (int i = start; i < x.size(); ++i) {
+            /**
+             * If x already assigned there is no branching to do.
+             * If x-range has space for an obligatory part of size p*size then we can branch.
+             */
+            if (branchable(i)) {
+                start = i; //update variable we are branching on
+                return true;
+            }
+        }
+        return false; //no more branching possible
+    }
+
+    // Return choice as description
+    virtual const Choice *choice(Space &home) {
+        /**
+         * The first branchable rectangle, or the branchable rectangle with the largest conflict weight (ties are
+         * broken by the order of the rectangles, larger squares first)
+         */
+        int pos = start;
+        if (select != INTERVAL_FIRST) {
+            double best = weight(home, start);
+            for (int i = start + 1; i < x.size(); ++i) {
+                if (branchable(i) && weight(home, i) > best) {
+                    best = weight(home, i);
+                    pos = i;
+                }
+            }
+        }
+        int obligatoryPartSize = std::ceil(obligatory() * w[pos]);
+        int lo = x[pos].min();
+        int len = w[pos] - obligatoryPartSize + 1;
+        int noAlternatives = std::min(k, (x[pos].max() - lo + len) / len);
+        /**
+         * k-way branching such that the first x-interval is [x.min(), x.min() + len - 1] = [x.min(), split], which
+         * enforces the obligatory part, every further interval of length len also enforces an obligatory part and the
+         * last interval is open ended, (split', x.max()]. With k = 2 this is the binary branching [x.min(), split],
+         * (split, x.max()].
+         * pos = current variable position we are branching on
+         */
+        return new Description(*this, noAlternatives, pos, lo, len);
+    }
+
+    // Construct choice from archive e
+    virtual const Choice *choice(const Space &, Archive &e) {
+        // Again, you have to take care of the additional information
+        unsigned int alternatives;
+        int pos, lo, len;
+        e >> alternatives >> pos >> lo >> len;
+        return new Description(*this, alternatives, pos, lo, len);
+    }
+
+    // Perform commit for choice c and alternative a
+    virtual ExecStatus commit(Space &home, const Choice &c, unsigned int a) {
+        const Description &d = static_cast<const Description &>(c);
+        // Deeper and after failed siblings the obligatory part gets smaller
+        level += 1 + a;
+        /**
+         * Alternative a, interval [lo + a*len, lo + (a+1)*len - 1], enforces obligatory part to be p % of side size.
+         * The last alternative is open ended, keep the values that are excluded by the other alternatives to keep
+         * the branches disjunctive.
+         */
+        if (a > 0) {
+            GECODE_ME_CHECK(x[d.pos].gq(home, d.lo + static_cast<int>(a) * d.len));
+        }
+        if (a + 1 < d.alternatives()) {
+            GECODE_ME_CHECK(x[d.pos].lq(home, d.lo + static_cast<int>(a + 1) * d.len - 1));
+        }
+        return ES_OK;
+    }
+
+    // Print some information on stream o (used by Gist, from Gecode 4.0.1 on)
+    virtual void print(const Space &home, const Choice &c, unsigned int b,
+                       std::ostream &o) const {
+
+        const Description &d = static_cast<const Description &>(c);
+
+        o << "Branch-alternative " << b << std::endl;
+        o << "x[" << d.pos << "]" << "| interval: [" << d.lo + static_cast<int>(b) * d.len << ",";
+        if (b + 1 < d.alternatives())
+            o << d.lo + static_cast<int>(b + 1) * d.len - 1 << "]";
+        else
+            o << x[d.pos].max() << "]";
+
+    }
+
+    // Dispose brancher and return its size, releases the activity
+    virtual size_t dispose(Space &home) {
+        if (select == INTERVAL_ACTIVITY) {
+            home.ignore(*this, AP_DISPOSE);
+            activity.~IntActivity();
+        }
+        (void) Brancher::dispose(home);
+        return sizeof(*this);
+    }
+};
+
+// This posts the interval branching, select chooses the rectangle and decay is the decay factor of AFC or activity.
+// Every choice has up to k intervals and p is multiplied with shrink per level of the brancher, the defaults are the
+// binary branching with a fixed p. Other views than IntView (OffsetView, MinusView) are posted with
+// IntervalBrancher<View>::post
+void interval(Home home, const IntVarArgs &x, const IntArgs &w, double p,
+              IntervalSelect select = INTERVAL_FIRST, double decay = 1.0, int k = 2, double shrink = 1.0);
+
+// The branchers for the views below are compiled into the common library
+extern template class IntervalBrancher<IntView>;
+extern template class IntervalBrancher<OffsetView>;
+extern template class IntervalBrancher<MinusView>;
+
+#endif
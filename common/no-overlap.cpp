@@ -0,0 +1,85 @@
+//
+// no-overlap.cpp
+// Post function and instantiations of the no-overlap propagators.
+//
+
+#include "no-overlap.hh"
+
+template class NoOverlap<IntView>;
+template class NoOverlap<OffsetView>;
+template class NoOverlap<MinusView>;
+template class NoOverlapSweep<IntView>;
+template class NoOverlapSweep<OffsetView>;
+template class NoOverlapSweep<MinusView>;
+template class NoOverlapIncremental<IntView>;
+template class NoOverlapIncremental<OffsetView>;
+template class NoOverlapIncremental<MinusView>;
+template class SquareNoOverlap<IntView, 2>;
+template class SquareNoOverlap<OffsetView, 2>;
+template class SquareNoOverlap<MinusView, 2>;
+template class SquareNoOverlap<IntView, 3>;
+template class SquareNoOverlap<OffsetView, 3>;
+template class SquareNoOverlap<MinusView, 3>;
+
+void nooverlap(Space &home,
+               const IntVarArgs &x, const IntArgs &w,
+               const IntVarArgs &y, const IntArgs &h,
+               NoOverlapAlgorithm algorithm) {
+    // Check whether the arguments make sense
+    if ((x.size() != y.size()) || (x.size() != w.size()) ||
+        (y.size() != h.size()))
+        throw ArgumentSizeMismatch("nooverlap");
+    // Never post a propagator in a failed space
+    if (home.failed()) return;
+    // Set up array of views for the coordinates
+    ViewArray<IntView> vx(home, x);
+    ViewArray<IntView> vy(home, y);
+    // Set up arrays (allocated in home) for width and height and initialize
+    int *wc = static_cast<Space &>(home).alloc<int>(x.size());
+    int *hc = static_cast<Space &>(home).alloc<int>(y.size());
+    for (int i = x.size(); i--;) {
+        wc[i] = w[i];
+        hc[i] = h[i];
+    }
+    // If posting failed, fail space
+    ExecStatus es;
+    switch (algorithm) {
+        case NOOVERLAP_SWEEP:
+            es = NoOverlapSweep<IntView>::post(home, vx, wc, vy, hc);
+            break;
+        case NOOVERLAP_ADVISOR:
+            es = NoOverlapIncremental<IntView>::post(home, vx, wc, vy, hc);
+            break;
+        default:
+            es = NoOverlap<IntView>::post(home, vx, wc, vy, hc);
+            break;
+    }
+    if (es != ES_OK)
+        home.fail();
+}
+
+void squarenooverlap(Space &home, const IntVarArgs &x, const IntVarArgs &y, const IntArgs &s) {
+    // Check whether the arguments make sense
+    if ((x.size() != y.size()) || (x.size() != s.size()))
+        throw ArgumentSizeMismatch("squarenooverlap");
+    // Never post a propagator in a failed space
+    if (home.failed()) return;
+    // Set up arrays of views for the coordinates
+    ViewArray<IntView> c[2] = {ViewArray<IntView>(home, x), ViewArray<IntView>(home, y)};
+    // If posting failed, fail space
+    if (SquareNoOverlap<IntView, 2>::post(home, c, IntSharedArray(s)) != ES_OK)
+        home.fail();
+}
+
+void squarenooverlap(Space &home, const IntVarArgs &x, const IntVarArgs &y, const IntVarArgs &z, const IntArgs &s) {
+    // Check whether the arguments make sense
+    if ((x.size() != y.size()) || (x.size() != z.size()) || (x.size() != s.size()))
+        throw ArgumentSizeMismatch("squarenooverlap");
+    // Never post a propagator in a failed space
+    if (home.failed()) return;
+    // Set up arrays of views for the coordinates
+    ViewArray<IntView> c[3] = {ViewArray<IntView>(home, x), ViewArray<IntView>(home, y), ViewArray<IntView>(home, z)};
+    // If posting failed, fail space
+    if (SquareNoOverlap<IntView, 3>::post(home, c, IntSharedArray(s)) != ES_OK)
+        home.fail();
+}
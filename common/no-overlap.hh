@@ -0,0 +1,725 @@
+/*
+ *  Main author:
+ *     Christian Schulte <cschulte@kth.se>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2009
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+//
+// no-overlap.hh
+// No-overlap propagators for rectangles, templated over the view type of the coordinates.
+//
+
+#ifndef COMMON_NO_OVERLAP_HH
+#define COMMON_NO_OVERLAP_HH
+
+#include <gecode/int.hh>
+
+using namespace Gecode;
+using namespace Gecode::Int;
+
+// The no-overlap propagator
+template<class View>
+class NoOverlap : public Propagator {
+protected:
+    // The x-coordinates
+    ViewArray<View> x;
+    // The width (array)
+    int *w;
+    // The y-coordinates
+    ViewArray<View> y;
+    // The heights (array)
+    int *h;
+public:
+    // Create propagator and initialize
+    NoOverlap(Home home, ViewArray<View> &x0, int w0[], ViewArray<View> &y0, int h0[]) :
+    //Initialize variables
+            Propagator(home),
+            x(x0),
+            w(w0),
+            y(y0),
+            h(h0) {
+        //Subscription controls the execution of hte propagator
+        x.subscribe(home, *this, PC_INT_BND); //Subscribe to changes in the x-view
+        y.subscribe(home, *this, PC_INT_BND); //Subscribe to changes in the y-view
+    }
+
+    // Post no-overlap propagator. Post function decides whether propagation is necessary and then creates the propagator
+    // if needed
+    static ExecStatus post(Home home, ViewArray<View> &x, int w[], ViewArray<View> &y, int h[]) {
+        // Only if there is something to propagate
+        if (x.size() > 1)
+            (void) new(home) NoOverlap(home, x, w, y, h);
+        return ES_OK;
+    }
+
+    // Copy constructor during cloning
+    NoOverlap(Space &home, bool share, NoOverlap &p)
+            : Propagator(home, share, p) {
+        x.update(home, share, p.x);
+        y.update(home, share, p.y);
+        // Also copy width and height arrays
+        w = home.alloc<int>(x.size());
+        h = home.alloc<int>(y.size());
+        for (int i = x.size(); i--;) {
+            w[i] = p.w[i];
+            h[i] = p.h[i];
+        }
+    }
+
+    // Create copy during cloning
+    virtual Propagator *copy(Space &home, bool share) {
+        return new(home) NoOverlap(home, share, *this);
+    }
+
+    // Re-schedule function after propagator has been re-enabled
+    virtual void reschedule(Space &home) {
+        x.reschedule(home, *this, PC_INT_BND);
+        y.reschedule(home, *this, PC_INT_BND);
+    }
+
+    // Return cost (defined as cheap quadratic complexity)
+    virtual PropCost cost(const Space &, const ModEventDelta &) const {
+        return PropCost::quadratic(PropCost::LO, 2 * x.size());
+    }
+
+    // Perform propagation
+    virtual ExecStatus propagate(Space &home, const ModEventDelta &) {
+        int assigned = 0; //Count how many of the variables are assigned to detect subsumption.
+        bool canOverlap = false;
+        for (int i = 0; i < x.size(); ++i) {
+            bool xCanOverlap = false;
+            bool yCanOverlap = false;
+            if (x[i].assigned() && y[i].assigned())
+                assigned++;
+            for (int j = 0; j < x.size(); ++j) {
+                if (j != i) {
+                    //square i and j overlaps on x-axis so propagate (bounds propagation) that they cant overlap on y-axis
+                    if
+                            (
+                            (x[i].max() <= x[j].min() && x[i].min() + w[i] > x[j].max()) ||
+                            (x[j].max() <= x[i].min() && x[j].min() + w[j] > x[i].max())
+                            )
+                    {
+                        if (y[i].max() <= y[j].min())
+                            GECODE_ME_CHECK(y[j].gq(home, y[i].min() + h[i]));
+
+                        if (y[i].min() + h[i] > y[j].max())
+                            GECODE_ME_CHECK(y[i].gr(home, y[j].min()));
+
+                        if (y[j].max() <= y[i].min())
+                            GECODE_ME_CHECK(y[i].gq(home, y[j].min() + h[j]));
+
+                        if (y[j].min() + h[j] > y[i].max())
+                            GECODE_ME_CHECK(y[j].gr(home, y[i].min()));
+                    }
+                    //square i and j overlaps on y-axis so propagate (bounds propagation) that they cant overlap on x-axis
+                    if
+                            (
+                            (y[i].max() <= y[j].min() && y[i].min() + h[i] > y[j].max()) ||
+                            (y[j].max() <= y[i].min() && y[j].min() + h[j] > y[i].max())
+                            )
+                    {
+                        if (x[i].max() <= x[j].min())
+                            GECODE_ME_CHECK(x[j].gq(home, x[i].min() + w[i]));
+
+                        if (x[i].min() + w[i] > x[j].max())
+                            GECODE_ME_CHECK(x[i].gr(home, x[j].min()));
+
+                        if (x[j].max() <= x[i].min())
+                            GECODE_ME_CHECK(x[i].gq(home, x[j].min() + w[j]));
+
+                        if (x[j].min() + w[j] > x[i].max())
+                            GECODE_ME_CHECK(x[j].gr(home, x[i].min()));
+                    }
+                    if (!xCanOverlap)
+                        xCanOverlap =
+                                //!(Condition where x_i and x_j can never overlap)
+                                //I.e if x_i and x_j can never overlap, xCanOverlap = false
+                                !(
+                                        ((x[i].min() > x[j].max()) || (x[i].max() + w[i] <= x[j].min()))
+                                        &&
+                                        ((x[j].min() > x[i].max()) || (x[j].max() + w[j] <= x[i].min()))
+
+                                );
+
+                    if (!yCanOverlap)
+                        yCanOverlap =
+                                //!(Condition where y_i and y_j can never overlap)
+                                //I.e if y_i and y_j can never overlap, yCanOverlap = false
+                                !(
+                                        ((y[i].min() > y[j].max()) || (y[i].max() + h[i] <= y[j].min()))
+                                        &&
+                                        ((y[j].min() > y[i].max()) || (y[j].max() + h[j] <= y[i].min()))
+
+                                );
+                }
+            }
+            if (!canOverlap)//If no previous squares could overlap, update the bool by checking if these 2 squares can overlap.
+                canOverlap = xCanOverlap && yCanOverlap;
+        }
+        if (!canOverlap)
+            return home.ES_SUBSUMED(*this); //No variable domains can overlap no matter assignment, no more propagation necessary
+
+        if (assigned == y.size())
+            return home.ES_SUBSUMED(*this); //All variables assigned, no more propagation necessary.
+        return ES_NOFIX; //Propagator is not idempotent, max and min bounds might change and affect propagation.
+    }
+
+    // Dispose propagator and return its size (dispose works as garbage collection, must cancel subscription first).
+    virtual size_t dispose(Space &home) {
+        x.cancel(home, *this, PC_INT_BND);
+        y.cancel(home, *this, PC_INT_BND);
+        (void) Propagator::dispose(home);
+        return sizeof(*this);
+    }
+};
+
+// The sweep-based no-overlap propagator
+// Instead of visiting every ordered pair (i, j) each axis is swept once over the compulsory parts
+// [max, min + size) of the rectangles. Two rectangles whose compulsory parts intersect on one axis overlap on that
+// axis no matter the assignment, so they must be disjoint on the other axis. Sorting costs O(n log n) per axis and
+// only the k pairs whose compulsory parts actually intersect are visited, i.e O(n log n + k) per call.
+template<class View>
+class NoOverlapSweep : public Propagator {
+protected:
+    // The x-coordinates
+    ViewArray<View> x;
+    // The width (array)
+    int *w;
+    // The y-coordinates
+    ViewArray<View> y;
+    // The heights (array)
+    int *h;
+
+    // Compulsory part of a rectangle along one axis
+    class Part {
+    public:
+        // Index of the rectangle
+        int i;
+        // Start (inclusive) and end (exclusive) of the compulsory part
+        int start, end;
+    };
+
+    // Sort order of the compulsory parts during the sweep
+    class PartLess {
+    public:
+        bool operator()(const Part &a, const Part &b) const {
+            return a.start < b.start;
+        }
+    };
+
+    // Rectangles i and j overlap on the swept axis, propagate that they can not overlap on the axis with coordinates c
+    // and sizes s (bounds propagation).
+    static ExecStatus disjoint(Space &home, ViewArray<View> &c, int s[], int i, int j, bool &modified) {
+        bool iFirst = c[i].min() + s[i] <= c[j].max(); //i can be placed before j
+        bool jFirst = c[j].min() + s[j] <= c[i].max(); //j can be placed before i
+        if (!iFirst && !jFirst)
+            return ES_FAILED;
+        if (!iFirst) { //j must be placed before i
+            ModEvent me = c[i].gq(home, c[j].min() + s[j]);
+            GECODE_ME_CHECK(me);
+            modified |= me_modified(me);
+            me = c[j].lq(home, c[i].max() - s[j]);
+            GECODE_ME_CHECK(me);
+            modified |= me_modified(me);
+        }
+        if (!jFirst) { //i must be placed before j
+            ModEvent me = c[j].gq(home, c[i].min() + s[i]);
+            GECODE_ME_CHECK(me);
+            modified |= me_modified(me);
+            me = c[i].lq(home, c[j].max() - s[i]);
+            GECODE_ME_CHECK(me);
+            modified |= me_modified(me);
+        }
+        return ES_OK;
+    }
+
+    // Sweep over the compulsory parts along the axis with coordinates p and sizes ps, every pair of intersecting
+    // compulsory parts is made disjoint along the axis with coordinates q and sizes qs.
+    static ExecStatus sweep(Space &home, ViewArray<View> &p, int ps[], ViewArray<View> &q, int qs[],
+                            bool &modified) {
+        Region r(home);
+        Part *parts = r.alloc<Part>(p.size());
+        int m = 0;
+        for (int i = 0; i < p.size(); ++i) {
+            if (p[i].max() < p[i].min() + ps[i]) { //Only rectangles with a non-empty compulsory part
+                parts[m].i = i;
+                parts[m].start = p[i].max();
+                parts[m].end = p[i].min() + ps[i];
+                m++;
+            }
+        }
+        PartLess less;
+        Support::quicksort<Part, PartLess>(parts, m, less);
+        //Parts that are still open at the current sweep position
+        int *open = r.alloc<int>(m);
+        int nOpen = 0;
+        for (int k = 0; k < m; ++k) {
+            int stillOpen = 0;
+            for (int l = 0; l < nOpen; ++l) {
+                const Part &o = parts[open[l]];
+                if (o.end > parts[k].start) {
+                    open[stillOpen++] = open[l];
+                    GECODE_ES_CHECK(disjoint(home, q, qs, o.i, parts[k].i, modified));
+                }
+            }
+            nOpen = stillOpen;
+            open[nOpen++] = k;
+        }
+        return ES_OK;
+    }
+
+public:
+    // Create propagator and initialize
+    NoOverlapSweep(Home home, ViewArray<View> &x0, int w0[], ViewArray<View> &y0, int h0[]) :
+            Propagator(home),
+            x(x0),
+            w(w0),
+            y(y0),
+            h(h0) {
+        x.subscribe(home, *this, PC_INT_BND);
+        y.subscribe(home, *this, PC_INT_BND);
+    }
+
+    // Post sweep-based no-overlap propagator
+    static ExecStatus post(Home home, ViewArray<View> &x, int w[], ViewArray<View> &y, int h[]) {
+        // Only if there is something to propagate
+        if (x.size() > 1)
+            (void) new(home) NoOverlapSweep(home, x, w, y, h);
+        return ES_OK;
+    }
+
+    // Copy constructor during cloning
+    NoOverlapSweep(Space &home, bool share, NoOverlapSweep &p)
+            : Propagator(home, share, p) {
+        x.update(home, share, p.x);
+        y.update(home, share, p.y);
+        // Also copy width and height arrays
+        w = home.alloc<int>(x.size());
+        h = home.alloc<int>(y.size());
+        for (int i = x.size(); i--;) {
+            w[i] = p.w[i];
+            h[i] = p.h[i];
+        }
+    }
+
+    // Create copy during cloning
+    virtual Propagator *copy(Space &home, bool share) {
+        return new(home) NoOverlapSweep(home, share, *this);
+    }
+
+    // Re-schedule function after propagator has been re-enabled
+    virtual void reschedule(Space &home) {
+        x.reschedule(home, *this, PC_INT_BND);
+        y.reschedule(home, *this, PC_INT_BND);
+    }
+
+    // Return cost (sorting dominates, n log n per axis)
+    virtual PropCost cost(const Space &, const ModEventDelta &) const {
+        return PropCost::linear(PropCost::HI, 2 * x.size());
+    }
+
+    // Perform propagation
+    virtual ExecStatus propagate(Space &home, const ModEventDelta &) {
+        bool modified = false;
+        //Rectangles forced to overlap on the x-axis can not overlap on the y-axis
+        GECODE_ES_CHECK(sweep(home, x, w, y, h, modified));
+        //Rectangles forced to overlap on the y-axis can not overlap on the x-axis
+        GECODE_ES_CHECK(sweep(home, y, h, x, w, modified));
+        if (modified)
+            return ES_NOFIX; //New compulsory parts might have appeared, run again.
+        for (int i = 0; i < x.size(); ++i)
+            if (!x[i].assigned() || !y[i].assigned())
+                return ES_FIX; //Nothing changed, the propagator is at fixpoint.
+        return home.ES_SUBSUMED(*this); //All variables assigned and checked, no more propagation necessary.
+    }
+
+    // Dispose propagator and return its size
+    virtual size_t dispose(Space &home) {
+        x.cancel(home, *this, PC_INT_BND);
+        y.cancel(home, *this, PC_INT_BND);
+        (void) Propagator::dispose(home);
+        return sizeof(*this);
+    }
+};
+
+// The incremental no-overlap propagator
+// One advisor per rectangle records which rectangles had their bounds modified since the last execution (the dirty
+// set), propagation then only re-checks the pairs involving a modified rectangle, O(n) per modified rectangle.
+template<class View>
+class NoOverlapIncremental : public Propagator {
+protected:
+    // Advisor of a single rectangle, subscribed to both its x- and y-coordinate
+    class Rectangle : public Advisor {
+    public:
+        // Index of the rectangle
+        int i;
+
+        // Create advisor and initialize
+        Rectangle(Space &home, Propagator &p, Council<Rectangle> &c, int i0)
+                : Advisor(home, p, c), i(i0) {}
+
+        // Copy constructor during cloning
+        Rectangle(Space &home, bool share, Rectangle &a)
+                : Advisor(home, share, a), i(a.i) {}
+    };
+
+    // The x-coordinates
+    ViewArray<View> x;
+    // The width (array)
+    int *w;
+    // The y-coordinates
+    ViewArray<View> y;
+    // The heights (array)
+    int *h;
+    // The advisors, one per rectangle
+    Council<Rectangle> c;
+    // Stack of rectangles modified since the last propagation
+    int *dirty;
+    // Number of rectangles on the stack
+    int nDirty;
+    // Whether a rectangle is on the stack
+    bool *isDirty;
+
+    // Push rectangle i on the dirty stack, returns false if it already was on it
+    bool mark(int i) {
+        if (isDirty[i])
+            return false;
+        isDirty[i] = true;
+        dirty[nDirty++] = i;
+        return true;
+    }
+
+    // Rectangles i and j overlap on the axis with coordinates p and sizes ps in every assignment
+    static bool overlap(ViewArray<View> &p, int ps[], int i, int j) {
+        return std::max(p[i].max(), p[j].max()) < std::min(p[i].min() + ps[i], p[j].min() + ps[j]);
+    }
+
+    // Rectangles i and j can not overlap on the axis with coordinates c and sizes s (bounds propagation)
+    static ExecStatus disjoint(Space &home, ViewArray<View> &c, int s[], int i, int j) {
+        bool iFirst = c[i].min() + s[i] <= c[j].max(); //i can be placed before j
+        bool jFirst = c[j].min() + s[j] <= c[i].max(); //j can be placed before i
+        if (!iFirst && !jFirst)
+            return ES_FAILED;
+        if (!iFirst) { //j must be placed before i
+            GECODE_ME_CHECK(c[i].gq(home, c[j].min() + s[j]));
+            GECODE_ME_CHECK(c[j].lq(home, c[i].max() - s[j]));
+        }
+        if (!jFirst) { //i must be placed before j
+            GECODE_ME_CHECK(c[j].gq(home, c[i].min() + s[i]));
+            GECODE_ME_CHECK(c[i].lq(home, c[j].max() - s[i]));
+        }
+        return ES_OK;
+    }
+
+public:
+    // Create propagator and initialize, every rectangle starts out as modified
+    NoOverlapIncremental(Home home, ViewArray<View> &x0, int w0[], ViewArray<View> &y0, int h0[]) :
+            Propagator(home),
+            x(x0),
+            w(w0),
+            y(y0),
+            h(h0),
+            c(home),
+            nDirty(0) {
+        dirty = static_cast<Space &>(home).alloc<int>(x.size());
+        isDirty = static_cast<Space &>(home).alloc<bool>(x.size());
+        for (int i = 0; i < x.size(); ++i) {
+            Rectangle *a = new(home) Rectangle(home, *this, c, i);
+            x[i].subscribe(home, *a);
+            y[i].subscribe(home, *a);
+            isDirty[i] = false;
+            mark(i);
+        }
+        View::schedule(home, *this, ME_INT_BND);
+    }
+
+    // Post incremental no-overlap propagator
+    static ExecStatus post(Home home, ViewArray<View> &x, int w[], ViewArray<View> &y, int h[]) {
+        // Only if there is something to propagate
+        if (x.size() > 1)
+            (void) new(home) NoOverlapIncremental(home, x, w, y, h);
+        return ES_OK;
+    }
+
+    // Copy constructor during cloning
+    NoOverlapIncremental(Space &home, bool share, NoOverlapIncremental &p)
+            : Propagator(home, share, p), nDirty(p.nDirty) {
+        x.update(home, share, p.x);
+        y.update(home, share, p.y);
+        c.update(home, share, p.c);
+        // Also copy width and height arrays and the dirty set
+        w = home.alloc<int>(x.size());
+        h = home.alloc<int>(y.size());
+        dirty = home.alloc<int>(x.size());
+        isDirty = home.alloc<bool>(x.size());
+        for (int i = x.size(); i--;) {
+            w[i] = p.w[i];
+            h[i] = p.h[i];
+            isDirty[i] = p.isDirty[i];
+        }
+        for (int i = nDirty; i--;)
+            dirty[i] = p.dirty[i];
+    }
+
+    // Create copy during cloning
+    virtual Propagator *copy(Space &home, bool share) {
+        return new(home) NoOverlapIncremental(home, share, *this);
+    }
+
+    // Re-schedule function after propagator has been re-enabled, modifications while disabled were not recorded
+    virtual void reschedule(Space &home) {
+        for (int i = 0; i < x.size(); ++i)
+            mark(i);
+        View::schedule(home, *this, ME_INT_BND);
+    }
+
+    // Return cost (linear in the number of rectangles per modified rectangle)
+    virtual PropCost cost(const Space &, const ModEventDelta &) const {
+        return PropCost::linear(PropCost::LO, x.size());
+    }
+
+    // Record the modified rectangle, only schedule the propagator if the rectangle was not already recorded
+    virtual ExecStatus advise(Space &, Advisor &a, const Delta &) {
+        return mark(static_cast<Rectangle &>(a).i) ? ES_NOFIX : ES_FIX;
+    }
+
+    // Perform propagation, pruning marks the pruned rectangles as modified so the loop runs until fixpoint
+    virtual ExecStatus propagate(Space &home, const ModEventDelta &) {
+        while (nDirty > 0) {
+            int i = dirty[--nDirty];
+            isDirty[i] = false;
+            for (int j = 0; j < x.size(); ++j) {
+                if (j != i) {
+                    //square i and j overlaps on x-axis so propagate that they cant overlap on y-axis
+                    if (overlap(x, w, i, j))
+                        GECODE_ES_CHECK(disjoint(home, y, h, i, j));
+                    //square i and j overlaps on y-axis so propagate that they cant overlap on x-axis
+                    if (overlap(y, h, i, j))
+                        GECODE_ES_CHECK(disjoint(home, x, w, i, j));
+                }
+            }
+        }
+        for (int i = 0; i < x.size(); ++i)
+            if (!x[i].assigned() || !y[i].assigned())
+                return ES_FIX;
+        return home.ES_SUBSUMED(*this); //All variables assigned and checked, no more propagation necessary.
+    }
+
+    // Dispose propagator and return its size, the advisors must cancel their subscriptions first
+    virtual size_t dispose(Space &home) {
+        for (Advisors<Rectangle> as(c); as(); ++as) {
+            x[as.advisor().i].cancel(home, as.advisor());
+            y[as.advisor().i].cancel(home, as.advisor());
+        }
+        c.dispose(home);
+        (void) Propagator::dispose(home);
+        return sizeof(*this);
+    }
+};
+
+// The no-overlap propagator for squares (or cubes)
+// A square has the same size along every axis, so there is a single size per square instead of a width and a height.
+// The sizes never change and are kept in an IntSharedArray, clones share the array instead of copying it. The number
+// of axes dim is a template parameter, 2 for squares and 3 for cubes. Two squares that overlap along all axes but one
+// in every assignment must be disjoint along the remaining axis (bounds propagation).
+template<class View, int dim>
+class SquareNoOverlap : public Propagator {
+protected:
+    // The coordinates, one array per axis
+    ViewArray<View> c[dim];
+    // The sizes, shared between clones
+    IntSharedArray s;
+
+    // Squares i and j overlap along axis d in every assignment
+    bool overlap(int d, int i, int j) const {
+        return std::max(c[d][i].max(), c[d][j].max()) < std::min(c[d][i].min() + s[i], c[d][j].min() + s[j]);
+    }
+
+    // Squares i and j can not overlap along axis d (bounds propagation)
+    ExecStatus disjoint(Space &home, int d, int i, int j, bool &modified) {
+        ViewArray<View> &p = c[d];
+        bool iFirst = p[i].min() + s[i] <= p[j].max(); //i can be placed before j
+        bool jFirst = p[j].min() + s[j] <= p[i].max(); //j can be placed before i
+        if (!iFirst && !jFirst)
+            return ES_FAILED;
+        if (!iFirst) { //j must be placed before i
+            ModEvent me = p[i].gq(home, p[j].min() + s[j]);
+            GECODE_ME_CHECK(me);
+            modified |= me_modified(me);
+            me = p[j].lq(home, p[i].max() - s[j]);
+            GECODE_ME_CHECK(me);
+            modified |= me_modified(me);
+        }
+        if (!jFirst) { //i must be placed before j
+            ModEvent me = p[j].gq(home, p[i].min() + s[i]);
+            GECODE_ME_CHECK(me);
+            modified |= me_modified(me);
+            me = p[i].lq(home, p[j].max() - s[i]);
+            GECODE_ME_CHECK(me);
+            modified |= me_modified(me);
+        }
+        return ES_OK;
+    }
+
+public:
+    // Create propagator and initialize
+    SquareNoOverlap(Home home, ViewArray<View> c0[dim], const IntSharedArray &s0) :
+            Propagator(home),
+            s(s0) {
+        for (int d = 0; d < dim; ++d) {
+            c[d] = c0[d];
+            c[d].subscribe(home, *this, PC_INT_BND);
+        }
+        // The reference to the sizes must be released when the propagator is disposed
+        home.notice(*this, AP_DISPOSE);
+    }
+
+    // Post no-overlap propagator for squares
+    static ExecStatus post(Home home, ViewArray<View> c[dim], const IntSharedArray &s) {
+        // Only if there is something to propagate
+        if (c[0].size() > 1)
+            (void) new(home) SquareNoOverlap(home, c, s);
+        return ES_OK;
+    }
+
+    // Copy constructor during cloning, only the handle of the sizes is copied when sharing
+    SquareNoOverlap(Space &home, bool share, SquareNoOverlap &p)
+            : Propagator(home, share, p) {
+        for (int d = 0; d < dim; ++d)
+            c[d].update(home, share, p.c[d]);
+        s.update(home, share, p.s);
+    }
+
+    // Create copy during cloning
+    virtual Propagator *copy(Space &home, bool share) {
+        return new(home) SquareNoOverlap(home, share, *this);
+    }
+
+    // Re-schedule function after propagator has been re-enabled
+    virtual void reschedule(Space &home) {
+        for (int d = 0; d < dim; ++d)
+            c[d].reschedule(home, *this, PC_INT_BND);
+    }
+
+    // Return cost (cheap quadratic complexity)
+    virtual PropCost cost(const Space &, const ModEventDelta &) const {
+        return PropCost::quadratic(PropCost::LO, dim * c[0].size());
+    }
+
+    // Perform propagation
+    virtual ExecStatus propagate(Space &home, const ModEventDelta &) {
+        bool modified = false;
+        int n = c[0].size();
+        for (int i = 0; i < n; ++i) {
+            for (int j = i + 1; j < n; ++j) {
+                //The axes along which square i and j can still be placed apart
+                int free = -1;
+                int nFree = 0;
+                for (int d = 0; d < dim && nFree < 2; ++d) {
+                    if (!overlap(d, i, j)) {
+                        free = d;
+                        nFree++;
+                    }
+                }
+                if (nFree == 0)
+                    return ES_FAILED; //Square i and j overlap along every axis
+                if (nFree == 1)
+                    GECODE_ES_CHECK(disjoint(home, free, i, j, modified));
+            }
+        }
+        if (modified)
+            return ES_NOFIX; //New compulsory overlaps might have appeared, run again.
+        for (int d = 0; d < dim; ++d)
+            if (!c[d].assigned())
+                return ES_FIX; //Nothing changed, the propagator is at fixpoint.
+        return home.ES_SUBSUMED(*this); //All variables assigned and checked, no more propagation necessary.
+    }
+
+    // Dispose propagator and return its size
+    virtual size_t dispose(Space &home) {
+        for (int d = 0; d < dim; ++d)
+            c[d].cancel(home, *this, PC_INT_BND);
+        home.ignore(*this, AP_DISPOSE);
+        s.~IntSharedArray();
+        (void) Propagator::dispose(home);
+        return sizeof(*this);
+    }
+};
+
+/*
+ * Propagation algorithm used by nooverlap.
+ */
+enum NoOverlapAlgorithm {
+    NOOVERLAP_PAIRWISE, // Visit every ordered pair of rectangles, O(n^2) per call
+    NOOVERLAP_SWEEP,    // Sweep over the compulsory parts, O(n log n) per axis
+    NOOVERLAP_ADVISOR   // Only re-check the pairs involving modified rectangles, O(n) per modified rectangle
+};
+
+/*
+ * Post the constraint that the rectangles defined by the coordinates
+ * x and y and width w and height h do not overlap.
+ *
+ * This is the function that you will call from your model, include this header and link the common library. Pass
+ * NOOVERLAP_SWEEP or NOOVERLAP_ADVISOR to use the sweep-based or the incremental propagator. Other views than IntView
+ * (OffsetView, MinusView) are posted with the post function of the propagator classes.
+ *
+ * Post function checks whether arguments are correct and whether the the space is failed or not before posting the
+ * propagator.
+ */
+void nooverlap(Space &home,
+               const IntVarArgs &x, const IntArgs &w,
+               const IntVarArgs &y, const IntArgs &h,
+               NoOverlapAlgorithm algorithm = NOOVERLAP_PAIRWISE);
+
+/*
+ * Post the constraint that the squares defined by the coordinates x and y and size s do not overlap. Does the same as
+ * nooverlap with w = h = s, the sizes are kept once and shared between clones.
+ */
+void squarenooverlap(Space &home, const IntVarArgs &x, const IntVarArgs &y, const IntArgs &s);
+
+/*
+ * Post the constraint that the cubes defined by the coordinates x, y and z and size s do not overlap.
+ */
+void squarenooverlap(Space &home, const IntVarArgs &x, const IntVarArgs &y, const IntVarArgs &z, const IntArgs &s);
+
+// The propagators for the views below are compiled into the common library
+extern template class NoOverlap<IntView>;
+extern template class NoOverlap<OffsetView>;
+extern template class NoOverlap<MinusView>;
+extern template class NoOverlapSweep<IntView>;
+extern template class NoOverlapSweep<OffsetView>;
+extern template class NoOverlapSweep<MinusView>;
+extern template class NoOverlapIncremental<IntView>;
+extern template class NoOverlapIncremental<OffsetView>;
+extern template class NoOverlapIncremental<MinusView>;
+extern template class SquareNoOverlap<IntView, 2>;
+extern template class SquareNoOverlap<OffsetView, 2>;
+extern template class SquareNoOverlap<MinusView, 2>;
+extern template class SquareNoOverlap<IntView, 3>;
+extern template class SquareNoOverlap<OffsetView, 3>;
+extern template class SquareNoOverlap<MinusView, 3>;
+
+#endif
@@ -0,0 +1,53 @@
+//
+// options.hh
+// Search options shared by all models.
+//
+
+#ifndef COMMON_OPTIONS_HH
+#define COMMON_OPTIONS_HH
+
+#include <gecode/driver.hh>
+#include <gecode/search.hh>
+
+using namespace Gecode;
+
+/**
+ * Parallel search is configured on the command line of every model:
+ * -threads  number of search threads, 1 = sequential (default), 0 = one per core,
+ *           n < 0 = all but n cores, 0 < n < 1 = fraction of the cores
+ * -c_d      commit recomputation distance, larger values copy less and steal larger subtrees
+ * -a_d      adaptive recomputation distance
+ *
+ * Script::run hands these to the DFS and BAB engines, drivers that set up their own engines (portfolio, subproblems,
+ * batch solving) use searchOptions so that the same flags apply to them.
+ */
+
+/**
+ * Search options from the commandline options.
+ *
+ * @param opt commandline options
+ * @param stop stop object for the engine, NULL for none
+ * @return
+ */
+inline Search::Options searchOptions(const Options &opt, Search::Stop *stop = NULL) {
+    Search::Options so;
+    so.threads = opt.threads();
+    so.c_d = opt.c_d();
+    so.a_d = opt.a_d();
+    so.stop = stop;
+    return so;
+}
+
+/**
+ * Number of threads requested with -threads, resolved against the number of cores.
+ *
+ * @param opt commandline options
+ * @return
+ */
+inline unsigned int threads(const Options &opt) {
+    Search::Options so;
+    so.threads = opt.threads();
+    return static_cast<unsigned int>(so.expand().threads);
+}
+
+#endif
@@ -33,8 +33,549 @@ Number of live cells:43
 #include <gecode/driver.hh>
 #include <gecode/int.hh>
 #include <gecode/minimodel.hh>
+#include "../../common/options.hh"
+#include "../../common/bab.hh"
+#include <climits>
 
 using namespace Gecode;
+using namespace Gecode::Int;
+
+/**
+ * Still-life propagator for the 3x3 neighbourhood of a cell, view 0 is the cell and views 1..8 are its neighbours.
+ * A live cell has two or three live neighbours and a dead cell does not have exactly three live neighbours.
+ * The 512 assignments of the neighbourhood are encoded as 9-bit masks (bit i for view i) and looked up in a table of
+ * the masks that satisfy the rule. Every completion of the assigned views is enumerated, a view that is 0 (or 1) in
+ * all valid completions is fixed to that value, which is domain consistent for the rule. Replaces three reified
+ * linear constraints and their auxiliary variables with one propagator per cell.
+ */
+class StillLife : public Propagator {
+protected:
+    // The cell and its neighbours
+    ViewArray<BoolView> x;
+
+    // The masks of the neighbourhood assignments that satisfy the rule
+    class Table {
+    public:
+        bool valid[512];
+
+        Table(void) {
+            for (int m = 0; m < 512; ++m) {
+                int neighbours = 0;
+                for (int i = 1; i < 9; ++i)
+                    neighbours += (m >> i) & 1;
+                valid[m] = (m & 1) ? (neighbours == 2 || neighbours == 3) : (neighbours != 3);
+            }
+        }
+    };
+
+    // The table is computed once and shared by all propagators (and search threads)
+    static const Table &table(void) {
+        static const Table t;
+        return t;
+    }
+
+public:
+    // Create propagator and initialize
+    StillLife(Home home, ViewArray<BoolView> &x0) : Propagator(home), x(x0) {
+        x.subscribe(home, *this, PC_BOOL_VAL);
+    }
+
+    // Post still-life propagator
+    static ExecStatus post(Home home, ViewArray<BoolView> &x) {
+        (void) new(home) StillLife(home, x);
+        return ES_OK;
+    }
+
+    // Copy constructor during cloning
+    StillLife(Space &home, bool share, StillLife &p) : Propagator(home, share, p) {
+        x.update(home, share, p.x);
+    }
+
+    // Create copy during cloning
+    virtual Propagator *copy(Space &home, bool share) {
+        return new(home) StillLife(home, share, *this);
+    }
+
+    // Re-schedule function after propagator has been re-enabled
+    virtual void reschedule(Space &home) {
+        x.reschedule(home, *this, PC_BOOL_VAL);
+    }
+
+    // Return cost (at most 512 table lookups)
+    virtual PropCost cost(const Space &, const ModEventDelta &) const {
+        return PropCost::linear(PropCost::HI, x.size());
+    }
+
+    // Perform propagation
+    virtual ExecStatus propagate(Space &home, const ModEventDelta &) {
+        const Table &t = table();
+        unsigned int unknown = 0;
+        unsigned int value = 0;
+        unsigned int nUnknown = 0;
+        for (int i = 0; i < 9; ++i) {
+            if (!x[i].assigned()) {
+                unknown |= 1u << i;
+                nUnknown++;
+            } else if (x[i].one()) {
+                value |= 1u << i;
+            }
+        }
+        /**
+         * Enumerate the completions of the assigned views (the subsets of the unassigned views), one collects the
+         * views that are 1 in some valid completion and zero the views that are 0 in some valid completion.
+         */
+        unsigned int one = 0;
+        unsigned int zero = 0;
+        unsigned int supports = 0;
+        for (unsigned int sub = unknown;; sub = (sub - 1) & unknown) {
+            unsigned int m = value | sub;
+            if (t.valid[m]) {
+                one |= m;
+                zero |= ~m;
+                supports++;
+            }
+            if (sub == 0)
+                break;
+        }
+        if (supports == 0)
+            return ES_FAILED;
+        if (supports == (1u << nUnknown))
+            return home.ES_SUBSUMED(*this); //Every completion is valid, also when all views are assigned.
+        for (int i = 0; i < 9; ++i) {
+            if (!x[i].assigned()) {
+                if (!(one & (1u << i)))
+                    GECODE_ME_CHECK(x[i].zero(home));
+                else if (!(zero & (1u << i)))
+                    GECODE_ME_CHECK(x[i].one(home));
+            }
+        }
+        return ES_FIX; //Fixing the supported values does not remove any valid completion, the propagator is idempotent.
+    }
+
+    // Dispose propagator and return its size
+    virtual size_t dispose(Space &home) {
+        x.cancel(home, *this, PC_BOOL_VAL);
+        (void) Propagator::dispose(home);
+        return sizeof(*this);
+    }
+};
+
+/**
+ * Post function for the still-life propagator.
+ *
+ * @param home
+ * @param cell the cell
+ * @param neighbours the 8 neighbours of the cell
+ */
+void stilllife(Space &home, BoolVar cell, const BoolVarArgs &neighbours) {
+    if (neighbours.size() != 8)
+        throw ArgumentSizeMismatch("stilllife");
+    // Never post a propagator in a failed space
+    if (home.failed()) return;
+    BoolVarArgs neighbourhood;
+    neighbourhood << cell << neighbours;
+    ViewArray<BoolView> x(home, neighbourhood);
+    // If posting failed, fail space
+    if (StillLife::post(home, x) != ES_OK)
+        home.fail();
+}
+
+/**
+ * Still-life propagator for a whole board of w columns and h rows (w, h <= 64), view r*w + c is the cell in row r and
+ * column c. The rule is enforced for all cells except the outermost rows and columns.
+ * The domains are kept as two 64-bit words per row, one has the bits of the cells that can be 1 and zero the bits of
+ * the cells that can be 0. The numbers of neighbours that are 1 and that can be 1 are computed for a whole row at once
+ * with bit-sliced adders on the shifted words of the rows above, below and the row itself. Propagation is the same as
+ * for StillLife (domain consistent per cell), but with one propagator and one advisor per cell instead of one
+ * propagator per cell. The advisors update the words and record the modified rows, only the modified rows and their
+ * neighbours are propagated.
+ */
+class StillLifeBoard : public Propagator {
+protected:
+    // Advisor of a single cell
+    class Cell : public Advisor {
+    public:
+        // Index of the cell
+        int i;
+
+        // Create advisor and initialize
+        Cell(Space &home, Propagator &p, Council<Cell> &c, int i0) : Advisor(home, p, c), i(i0) {}
+
+        // Copy constructor during cloning
+        Cell(Space &home, bool share, Cell &a) : Advisor(home, share, a), i(a.i) {}
+    };
+
+    // Bit-sliced counters, word k has bit k of the count of every column, counts are at most 8
+    class Count {
+    public:
+        unsigned long long s0, s1, s2, s3;
+
+        Count(void) : s0(0), s1(0), s2(0), s3(0) {}
+
+        // Add the bits of b to the counts
+        void add(unsigned long long b) {
+            unsigned long long c0 = s0 & b;
+            s0 ^= b;
+            unsigned long long c1 = s1 & c0;
+            s1 ^= c0;
+            unsigned long long c2 = s2 & c1;
+            s2 ^= c1;
+            s3 |= c2;
+        }
+
+        // Columns with count k
+        unsigned long long eq(int k) const {
+            return ((k & 1) ? s0 : ~s0) & ((k & 2) ? s1 : ~s1) & ((k & 4) ? s2 : ~s2) & ((k & 8) ? s3 : ~s3);
+        }
+
+        // Columns with count at least 2
+        unsigned long long ge2(void) const {
+            return s1 | s2 | s3;
+        }
+
+        // Columns with count at most 3
+        unsigned long long le3(void) const {
+            return ~(s2 | s3);
+        }
+    };
+
+    // The cells
+    ViewArray<BoolView> x;
+    // Columns and rows of the board
+    int w, h;
+    // Per row the cells that can be 1 and the cells that can be 0
+    unsigned long long *one, *zero;
+    // Rows with modified cells since the last propagation
+    unsigned long long dirty;
+    // The advisors, one per cell
+    Council<Cell> c;
+
+    // All columns
+    unsigned long long columns(void) const {
+        return w == 64 ? ~0ULL : (1ULL << w) - 1;
+    }
+
+    // The columns of the cells that the rule is enforced for
+    unsigned long long inner(void) const {
+        return columns() & ~1ULL & ~(1ULL << (w - 1));
+    }
+
+    // Read the words from the views, all rows are modified
+    void read(void) {
+        for (int r = 0; r < h; ++r) {
+            one[r] = zero[r] = 0;
+            for (int k = 0; k < w; ++k) {
+                if (!x[r * w + k].zero())
+                    one[r] |= 1ULL << k;
+                if (!x[r * w + k].one())
+                    zero[r] |= 1ULL << k;
+            }
+        }
+        dirty = h == 64 ? ~0ULL : (1ULL << h) - 1;
+    }
+
+    // Neighbour counts of row r, of the cells that are 1 if fixed is true and else of the cells that can be 1
+    Count neighbours(int r, bool fixed) const {
+        Count n;
+        for (int k = r - 1; k <= r + 1; ++k) {
+            if (k < 0 || k >= h)
+                continue;
+            unsigned long long b = fixed ? one[k] & ~zero[k] : one[k];
+            n.add(b << 1);
+            n.add(b >> 1);
+            if (k != r)
+                n.add(b);
+        }
+        return n;
+    }
+
+    // Fix the cells of row r with bits in m to value v
+    ExecStatus fix(Space &home, int r, unsigned long long m, bool v) {
+        unsigned long long &keep = v ? one[r] : zero[r];
+        unsigned long long &drop = v ? zero[r] : one[r];
+        if (m & ~keep)
+            return ES_FAILED;
+        // Only the cells that are not fixed yet, the words are updated first so the advisors ignore the modification
+        m &= drop;
+        if (m == 0)
+            return ES_OK;
+        drop &= ~m;
+        dirty |= 1ULL << r;
+        while (m != 0) {
+            int k = __builtin_ctzll(m);
+            m &= m - 1;
+            GECODE_ME_CHECK(v ? x[r * w + k].one(home) : x[r * w + k].zero(home));
+        }
+        return ES_OK;
+    }
+
+    // Propagate the rule for the cells of row r
+    ExecStatus row(Space &home, int r) {
+        Count lo = neighbours(r, true);
+        Count hi = neighbours(r, false);
+        unsigned long long in = inner();
+        /**
+         * A cell can be 1 if 2 or 3 neighbours can be 1 and can be 0 unless exactly 3 neighbours are 1.
+         */
+        unsigned long long aliveOk = lo.le3() & hi.ge2();
+        unsigned long long deadOk = ~(lo.eq(3) & hi.eq(3));
+        if (in & ~((one[r] & aliveOk) | (zero[r] & deadOk)))
+            return ES_FAILED;
+        unsigned long long unknown = one[r] & zero[r] & in;
+        GECODE_ES_CHECK(fix(home, r, unknown & ~aliveOk, false));
+        GECODE_ES_CHECK(fix(home, r, unknown & ~deadOk, true));
+        /**
+         * The unknown neighbours of a live cell with 3 live neighbours are 0, with only 2 possible ones they are 1.
+         * The unknown neighbour of a dead cell with 2 live and 3 possible neighbours is 0, with 3 live and 4 possible
+         * neighbours it is 1.
+         */
+        unsigned long long alive = one[r] & ~zero[r] & in;
+        unsigned long long dead = zero[r] & ~one[r] & in;
+        unsigned long long toZero = (alive & lo.eq(3)) | (dead & lo.eq(2) & hi.eq(3));
+        unsigned long long toOne = (alive & hi.eq(2)) | (dead & lo.eq(3) & hi.eq(4));
+        for (int k = r - 1; k <= r + 1; ++k) {
+            unsigned long long z = (toZero << 1 | toZero >> 1 | (k != r ? toZero : 0)) & columns();
+            unsigned long long o = (toOne << 1 | toOne >> 1 | (k != r ? toOne : 0)) & columns();
+            GECODE_ES_CHECK(fix(home, k, z & one[k] & zero[k], false));
+            GECODE_ES_CHECK(fix(home, k, o & one[k] & zero[k], true));
+        }
+        return ES_OK;
+    }
+
+public:
+    // Create propagator and initialize
+    StillLifeBoard(Home home, ViewArray<BoolView> &x0, int w0) :
+            Propagator(home), x(x0), w(w0), h(x0.size() / w0), c(home) {
+        one = static_cast<Space &>(home).alloc<unsigned long long>(h);
+        zero = static_cast<Space &>(home).alloc<unsigned long long>(h);
+        read();
+        for (int i = 0; i < x.size(); ++i)
+            x[i].subscribe(home, *new(home) Cell(home, *this, c, i));
+        BoolView::schedule(home, *this, ME_BOOL_VAL);
+    }
+
+    // Post board propagator
+    static ExecStatus post(Home home, ViewArray<BoolView> &x, int w) {
+        (void) new(home) StillLifeBoard(home, x, w);
+        return ES_OK;
+    }
+
+    // Copy constructor during cloning
+    StillLifeBoard(Space &home, bool share, StillLifeBoard &p)
+            : Propagator(home, share, p), w(p.w), h(p.h), dirty(p.dirty) {
+        x.update(home, share, p.x);
+        c.update(home, share, p.c);
+        one = home.alloc<unsigned long long>(h);
+        zero = home.alloc<unsigned long long>(h);
+        for (int r = h; r--;) {
+            one[r] = p.one[r];
+            zero[r] = p.zero[r];
+        }
+    }
+
+    // Create copy during cloning
+    virtual Propagator *copy(Space &home, bool share) {
+        return new(home) StillLifeBoard(home, share, *this);
+    }
+
+    // Re-schedule function after propagator has been re-enabled, modifications while disabled were not recorded
+    virtual void reschedule(Space &home) {
+        read();
+        BoolView::schedule(home, *this, ME_BOOL_VAL);
+    }
+
+    // Return cost (linear in the number of rows, a word per row)
+    virtual PropCost cost(const Space &, const ModEventDelta &) const {
+        return PropCost::linear(PropCost::HI, h);
+    }
+
+    // Record the fixed cell in the words, only schedule the propagator if the words change
+    virtual ExecStatus advise(Space &, Advisor &a, const Delta &) {
+        int i = static_cast<Cell &>(a).i;
+        int r = i / w;
+        unsigned long long bit = 1ULL << (i % w);
+        unsigned long long &drop = x[i].one() ? zero[r] : one[r];
+        if (!(drop & bit))
+            return ES_FIX;
+        drop &= ~bit;
+        dirty |= 1ULL << r;
+        return ES_NOFIX;
+    }
+
+    // Perform propagation, the modified rows and their neighbours until no row is modified
+    virtual ExecStatus propagate(Space &home, const ModEventDelta &) {
+        unsigned long long rows = h == 64 ? ~0ULL : (1ULL << h) - 1;
+        rows &= ~1ULL & ~(1ULL << (h - 1));
+        while (dirty != 0) {
+            unsigned long long todo = (dirty | dirty << 1 | dirty >> 1) & rows;
+            dirty = 0;
+            while (todo != 0) {
+                int r = __builtin_ctzll(todo);
+                todo &= todo - 1;
+                GECODE_ES_CHECK(row(home, r));
+            }
+        }
+        for (int r = 0; r < h; ++r)
+            if (one[r] & zero[r])
+                return ES_FIX;
+        return home.ES_SUBSUMED(*this); //All cells assigned and checked, no more propagation necessary.
+    }
+
+    // Dispose propagator and return its size, the advisors must cancel their subscriptions first
+    virtual size_t dispose(Space &home) {
+        for (Advisors<Cell> as(c); as(); ++as)
+            x[as.advisor().i].cancel(home, as.advisor());
+        c.dispose(home);
+        (void) Propagator::dispose(home);
+        return sizeof(*this);
+    }
+};
+
+/**
+ * Post function for the board propagator.
+ *
+ * @param home
+ * @param cells the cells of the board, row by row
+ * @param w the number of columns, at most 64, and at most 64 rows
+ */
+void stilllife(Space &home, const BoolVarArgs &cells, int w) {
+    if (w < 3 || w > 64 || cells.size() % w != 0 || cells.size() / w < 3 || cells.size() / w > 64)
+        throw OutOfLimits("stilllife");
+    // Never post a propagator in a failed space
+    if (home.failed()) return;
+    ViewArray<BoolView> x(home, cells);
+    // If posting failed, fail space
+    if (StillLifeBoard::post(home, x, w) != ES_OK)
+        home.fail();
+}
+
+/**
+ * Upper bound on the density (number of live cells) of a still life on an n x n board, for pruning in BAB.
+ * The board is split into bands of 1, 2 or 3 rows and every band into tiles of 1, 2 or 3 columns. A tile has at most
+ * as many live cells as cells that can still be live, and at most as many as a still life can have in an area of its
+ * size: 6 in 3x3, 4 in 2x3, 3x2 and 2x2. Dynamic programming over the rows, and over the columns of every band, finds
+ * the tiling with the smallest sum of the tile bounds, the density is at most that sum.
+ */
+class DensityBound : public Propagator {
+protected:
+    // The cells, row by row
+    ViewArray<BoolView> x;
+    // Size of the board
+    int n;
+    // The density
+    IntView d;
+
+    // Maximal number of live cells of a still life in an area of b rows and w columns (b, w <= 3)
+    static int cap(int b, int w) {
+        static const int caps[4][4] = {{0, 0, 0, 0},
+                                       {0, 1, 2, 3},
+                                       {0, 2, 4, 4},
+                                       {0, 3, 4, 6}};
+        return caps[b][w];
+    }
+
+public:
+    // Create propagator and initialize
+    DensityBound(Home home, ViewArray<BoolView> &x0, int n0, IntView d0) : Propagator(home), x(x0), n(n0), d(d0) {
+        x.subscribe(home, *this, PC_BOOL_VAL);
+    }
+
+    // Post density bound propagator
+    static ExecStatus post(Home home, ViewArray<BoolView> &x, int n, IntView d) {
+        (void) new(home) DensityBound(home, x, n, d);
+        return ES_OK;
+    }
+
+    // Copy constructor during cloning
+    DensityBound(Space &home, bool share, DensityBound &p) : Propagator(home, share, p), n(p.n) {
+        x.update(home, share, p.x);
+        d.update(home, share, p.d);
+    }
+
+    // Create copy during cloning
+    virtual Propagator *copy(Space &home, bool share) {
+        return new(home) DensityBound(home, share, *this);
+    }
+
+    // Re-schedule function after propagator has been re-enabled
+    virtual void reschedule(Space &home) {
+        x.reschedule(home, *this, PC_BOOL_VAL);
+    }
+
+    // Return cost (quadratic in n, linear in the number of cells)
+    virtual PropCost cost(const Space &, const ModEventDelta &) const {
+        return PropCost::linear(PropCost::HI, x.size());
+    }
+
+    // Perform propagation
+    virtual ExecStatus propagate(Space &home, const ModEventDelta &) {
+        Region r(home);
+        /**
+         * live[i*(n+1) + j] is the number of cells in rows < i and columns < j that can be live.
+         */
+        int m = n + 1;
+        int *live = r.alloc<int>(m * m);
+        for (int j = 0; j < m; ++j)
+            live[j] = 0;
+        for (int i = 0; i < n; ++i) {
+            live[(i + 1) * m] = 0;
+            for (int j = 0; j < n; ++j)
+                live[(i + 1) * m + j + 1] = live[i * m + j + 1] + live[(i + 1) * m + j] - live[i * m + j] +
+                                            (x[i * n + j].zero() ? 0 : 1);
+        }
+        /**
+         * rows[i] is the bound of rows i..n-1, cols[j] the bound of columns j..n-1 of the current band.
+         */
+        int *rows = r.alloc<int>(m);
+        int *cols = r.alloc<int>(m);
+        rows[n] = 0;
+        cols[n] = 0;
+        for (int i = n; i--;) {
+            rows[i] = INT_MAX;
+            for (int b = 1; b <= 3 && i + b <= n; ++b) {
+                for (int j = n; j--;) {
+                    cols[j] = INT_MAX;
+                    for (int w = 1; w <= 3 && j + w <= n; ++w) {
+                        int tile = live[(i + b) * m + j + w] - live[i * m + j + w] - live[(i + b) * m + j] +
+                                   live[i * m + j];
+                        cols[j] = std::min(cols[j], std::min(cap(b, w), tile) + cols[j + w]);
+                    }
+                }
+                rows[i] = std::min(rows[i], cols[0] + rows[i + b]);
+            }
+        }
+        GECODE_ME_CHECK(d.lq(home, rows[0]));
+        if (x.assigned())
+            return home.ES_SUBSUMED(*this); //The density is the sum of the cells, which is propagated by linear.
+        return ES_FIX; //The bound only depends on the cells.
+    }
+
+    // Dispose propagator and return its size
+    virtual size_t dispose(Space &home) {
+        x.cancel(home, *this, PC_BOOL_VAL);
+        (void) Propagator::dispose(home);
+        return sizeof(*this);
+    }
+};
+
+/**
+ * Post function for the density bound propagator.
+ *
+ * @param home
+ * @param cells the n x n cells of the board, row by row
+ * @param n the size of the board
+ * @param density at most the number of live cells
+ */
+void densitybound(Space &home, const BoolVarArgs &cells, int n, IntVar density) {
+    if (cells.size() != n * n)
+        throw ArgumentSizeMismatch("densitybound");
+    // Never post a propagator in a failed space
+    if (home.failed()) return;
+    ViewArray<BoolView> x(home, cells);
+    // If posting failed, fail space
+    if (DensityBound::post(home, x, n, IntView(density)) != ES_OK)
+        home.fail();
+}
 
 /**
  *  Script that finds maximum density still life patterns. For execution instructions see comments at bottom of file.
@@ -45,16 +586,48 @@ using namespace Gecode;
 class Life : public Script {
 
 public:
+    /// Propagation of the still-life rule
+    enum {
+        PROP_REIFIED,   ///< Three reified linear constraints per cell
+        PROP_STILLLIFE, ///< One still-life propagator per cell
+        PROP_BOARD      ///< One still-life propagator for the board, rows as bitmasks
+    };
+    /// Bound on the density
+    enum {
+        MODEL_PLAIN, ///< Only the 3x3 squares
+        MODEL_BOUND  ///< Also the dynamic-programming tiling bound
+    };
+    /// Symmetry breaking over the rotations and reflections of the board
+    enum {
+        SYMMETRY_NONE, ///< No symmetry breaking
+        SYMMETRY_LEX,  ///< Lex-leader constraints
+        SYMMETRY_LDSB  ///< Lightweight dynamic symmetry breaking in the branching
+    };
+    /// Variable selection of the cell branching
+    enum {
+        BRANCH_SIZE,   ///< Largest domain first
+        BRANCH_RANDOM  ///< Random cell (for restarts)
+    };
+    /// Search engine
+    enum {
+        SEARCH_BAB,      ///< Branch-and-bound, -threads for Gecode's parallel engine
+        SEARCH_PARALLEL  ///< Workers on subproblems sharing the best density
+    };
 
     const int n;
     BoolVarArray cells;
     IntVarArray threeSquares;
+    IntVar density;
+    /// Best density of all workers with -search parallel, NULL otherwise
+    SharedBound *bound;
 
-    Life(const SizeOptions &opt) :
+    Life(const SizeOptions &opt, SharedBound *bound0 = NULL) :
             Script(opt),
             n(opt.size()),
             cells(*this, (n + 4) * (n + 4), 0, 1),
-            threeSquares(*this, noThreeSquares(n), 0, 6) {
+            threeSquares(*this, noThreeSquares(n), 0, 6),
+            density(*this, 0, n * n),
+            bound(bound0) {
 
         Matrix <BoolVarArray> cellsMatrix(cells, n + 4, n + 4);
 
@@ -72,6 +645,12 @@ public:
         rel(*this, sum(cellsMatrix.col(0)) == 0);
         rel(*this, sum(cellsMatrix.col(1)) == 0);
 
+        /**
+         * The still-life rule for all cells at once, rows of at most 64 cells (n <= 60)
+         */
+        if (opt.propagation() == PROP_BOARD)
+            stilllife(*this, cells, n + 4);
+
         /**
          * Constraints on each individual cell to ensure pattern does not spread and also construction of
          * sum of 3x3 squares.
@@ -96,9 +675,13 @@ public:
                  * live cell with > 3 live neighbors dies
                  * dead cell with 3 live neighbors becomes live
                  */
-                rel(*this, cellsMatrix(i, j) >> (sum(neighborCells) >= 2));
-                rel(*this, cellsMatrix(i, j) >> (sum(neighborCells) <= 3));
-                rel(*this, !cellsMatrix(i, j) >> (sum(neighborCells) != 3));
+                if (opt.propagation() == PROP_STILLLIFE) {
+                    stilllife(*this, cellsMatrix(i, j), neighborCells);
+                } else if (opt.propagation() == PROP_REIFIED) {
+                    rel(*this, cellsMatrix(i, j) >> (sum(neighborCells) >= 2));
+                    rel(*this, cellsMatrix(i, j) >> (sum(neighborCells) <= 3));
+                    rel(*this, !cellsMatrix(i, j) >> (sum(neighborCells) != 3));
+                }
 
                 /**
                  * Constrain 3x3 squares for optimization.
@@ -113,17 +696,54 @@ public:
                 }
             }
         }
+        /**
+         * The density is the number of live cells, with the tiling bound nodes that can not beat the best solution
+         * so far fail as soon as the bound drops below it.
+         */
+        linear(*this, cells, IRT_EQ, density);
+        if (opt.model() == MODEL_BOUND)
+            densitybound(*this, cellsMatrix.slice(2, n + 2, 2, n + 2), n, density);
+
+        /**
+         * Symmetry breaking, the 8 rotations and reflections of a still life are still lifes with the same density.
+         * Lex-leader: the board read row by row is lexicographically at least as large as each of its 7 images, this
+         * keeps the pattern of every class that the branching (cells in order, 1 first) finds first.
+         */
+        if (opt.symmetry() == SYMMETRY_LEX) {
+            BoolVarArgs board = cellsMatrix.slice(2, n + 2, 2, n + 2);
+            for (int s = 1; s < 8; ++s)
+                rel(*this, board, IRT_GQ, image(cellsMatrix, s));
+        }
+
         /**
          * Branching strategy
+         * With LDSB the images of a refuted choice under the reflections of the board (which generate the rotations)
+         * are excluded as well.
          */
-        branch(*this, cells, INT_VAR_SIZE_MAX(), INT_VAL_MAX());
+        Symmetries symmetries;
+        if (opt.symmetry() == SYMMETRY_LDSB)
+            symmetries << rows_reflect(cellsMatrix) << columns_reflect(cellsMatrix) << diagonal_reflect(cellsMatrix);
+        if (opt.branching() == BRANCH_RANDOM) {
+            //All unassigned cells have the same domain, random ties make every restart explore a different tree
+            Rnd r(opt.seed());
+            if (opt.symmetry() == SYMMETRY_LDSB)
+                branch(*this, cells, tiebreak(INT_VAR_SIZE_MAX(), INT_VAR_RND(r)), INT_VAL_MAX(), symmetries);
+            else
+                branch(*this, cells, tiebreak(INT_VAR_SIZE_MAX(), INT_VAR_RND(r)), INT_VAL_MAX());
+        } else {
+            if (opt.symmetry() == SYMMETRY_LDSB)
+                branch(*this, cells, INT_VAR_SIZE_MAX(), INT_VAL_MAX(), symmetries);
+            else
+                branch(*this, cells, INT_VAR_SIZE_MAX(), INT_VAL_MAX());
+        }
         //branch(*this, cells, INT_VAR_SIZE_MIN(), INT_VAL_MIN());
     }
 
     /// Constructor for cloning
-    Life(bool share, Life &space) : Script(share, space), n(space.n) {
+    Life(bool share, Life &space) : Script(share, space), n(space.n), bound(space.bound) {
         cells.update(*this, share, space.cells);
         threeSquares.update(*this, share, space.threeSquares);
+        density.update(*this, share, space.density);
     }
 
     /// Perform copying during cloning
@@ -147,6 +767,42 @@ public:
         os << "Number of live cells:" << sum << std::endl;
     }
 
+    /**
+     * Image of the n x n board (without the border) under rotation or reflection s, row by row.
+     * 1-3 rotate by 90, 180 and 270 degrees, 4 and 5 reflect the rows and the columns, 6 and 7 reflect on the diagonal
+     * and the anti-diagonal.
+     *
+     * @param m the board with the border
+     * @param s the rotation or reflection, 1..7
+     * @return
+     */
+    BoolVarArgs image(const Matrix <BoolVarArray> &m, int s) const {
+        BoolVarArgs y;
+        for (int r = 0; r < n; ++r) {
+            for (int c = 0; c < n; ++c) {
+                //Row and column of the cell that is moved to (r, c)
+                int i = r, j = c;
+                switch (s) {
+                    case 1: i = c; j = n - 1 - r; break;
+                    case 2: i = n - 1 - r; j = n - 1 - c; break;
+                    case 3: i = n - 1 - c; j = r; break;
+                    case 4: i = n - 1 - r; break;
+                    case 5: j = n - 1 - c; break;
+                    case 6: i = c; j = r; break;
+                    case 7: i = n - 1 - c; j = n - 1 - r; break;
+                    default: break;
+                }
+                y << m(j + 2, i + 2);
+            }
+        }
+        return y;
+    }
+
+    /// The density, maximized
+    IntVar cost(void) const {
+        return density;
+    }
+
     /**
      * Auxillary function returning number of 3x3 squares given an n.
      *
@@ -158,14 +814,18 @@ public:
     }
 
     /**
-     * Maximize the sum of values of the individual cells.
+     * Maximize the sum of values of the individual cells. With -restart, Gecode's default master also posts this on
+     * the best solution so far after every restart. With -search parallel the density must also beat the best density
+     * of all workers.
      *
      * @param space
      */
     virtual void constrain(const Space &space) {
         const Life &home = static_cast<const Life &>(space);
         rel(*this, sum(threeSquares) > sum(home.threeSquares));
-        rel(*this, sum(cells) > sum(home.cells));
+        rel(*this, density > home.density.val());
+        if (bound != NULL && bound->set())
+            rel(*this, density > bound->value());
     }
 };
 
@@ -186,18 +846,45 @@ int main(int argc, char *argv[]) {
     opt.size(10); //n size
     opt.mode(ScriptMode::SM_SOLUTION); //Solution mode (i.e no GIST) is default
     opt.ipl(IPL_DEF); //Default propagation strength
+    opt.propagation(Life::PROP_STILLLIFE);
+    opt.propagation(Life::PROP_REIFIED, "reified", "three reified linear constraints per cell");
+    opt.propagation(Life::PROP_STILLLIFE, "stilllife", "one still-life propagator per cell");
+    opt.propagation(Life::PROP_BOARD, "board", "one still-life propagator for the board (n <= 60)");
+    opt.model(Life::MODEL_BOUND);
+    opt.model(Life::MODEL_PLAIN, "plain", "3x3 squares only");
+    opt.model(Life::MODEL_BOUND, "bound", "dynamic-programming tiling bound on the density");
+    opt.symmetry(Life::SYMMETRY_NONE);
+    opt.symmetry(Life::SYMMETRY_NONE, "none", "no symmetry breaking");
+    opt.symmetry(Life::SYMMETRY_LEX, "lex", "lex-leader constraints over the rotations and reflections");
+    opt.symmetry(Life::SYMMETRY_LDSB, "ldsb", "lightweight dynamic symmetry breaking over the reflections");
+    opt.branching(Life::BRANCH_SIZE);
+    opt.branching(Life::BRANCH_SIZE, "size", "largest domain first");
+    opt.branching(Life::BRANCH_RANDOM, "random", "random cell, use with -restart");
+    opt.search(Life::SEARCH_BAB);
+    opt.search(Life::SEARCH_BAB, "bab", "branch-and-bound");
+    opt.search(Life::SEARCH_PARALLEL, "parallel", "-threads workers sharing the best density");
     opt.parse(argc, argv);
 
     //parse cmd (potentially overwrite default options)
     opt.parse(argc, argv);
 
-    //run script with BAB engine
-    Script::run<Life, BAB, SizeOptions>(opt);
+    //run script with BAB engine (RBS around BAB with -restart), or the workers sharing the best density
+    if (opt.search() == Life::SEARCH_PARALLEL)
+        parallelbab<Life>(opt, false);
+    else
+        Script::run<Life, BAB, SizeOptions>(opt);
 
     /**
      * Example cmd to solve:
      * ./bin/life 8
      * ./bin/life 9
+     * ./bin/life -threads 0 -c_d 16 9
+     * ./bin/life -branching random -seed 3 -restart luby -restart-scale 500 12
+     * ./bin/life -mode stat -propagation reified 9
+     * ./bin/life -mode stat -propagation board 9
+     * ./bin/life -mode stat -model plain 9
+     * ./bin/life -mode stat -symmetry lex 10
+     * ./bin/life -search parallel -threads 8 14
      *
      */
     return 0;
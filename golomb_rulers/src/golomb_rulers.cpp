@@ -28,19 +28,29 @@
 #include <gecode/driver.hh>
 #include <gecode/int.hh>
 #include <gecode/minimodel.hh>
+#include "../../common/options.hh"
+#include "../../common/bab.hh"
 
 using namespace Gecode;
 
 class GolombRuler : public IntMinimizeScript {
 protected:
     IntVarArray m;
+    // Best length of all workers with -search parallel, NULL otherwise
+    SharedBound* bound;
 public:
-    GolombRuler(const SizeOptions& opt)
+    /// Search engine
+    enum {
+        SEARCH_BAB,      ///< Branch-and-bound, -threads for Gecode's parallel engine
+        SEARCH_PARALLEL  ///< Workers on subproblems sharing the best length
+    };
+    GolombRuler(const SizeOptions& opt, SharedBound* bound0 = NULL)
             : IntMinimizeScript(opt),
               m(*this,opt.size(),0,
                 (opt.size() < 31)
                 ? (1 << (opt.size()-1)) - 1
-                : Int::Limits::max) {
+                : Int::Limits::max),
+              bound(bound0) {
         // constraining marks
         rel(*this, m[0], IRT_EQ, 0);
         rel(*this, m, IRT_LE);
@@ -67,13 +77,19 @@ public:
     virtual IntVar cost(void) const {
         return m[m.size()-1];
     }
+    /// Shorter than the best solution, and than the best length of all workers
+    virtual void constrain(const Space& s) {
+        IntMinimizeScript::constrain(s);
+        if (bound != NULL && bound->set())
+            rel(*this, cost(), IRT_LE, bound->value());
+    }
     /// Print solution
     virtual void print(std::ostream& os) const {
         os << m << std::endl;
     }
     // Constructor for cloning \a s
     GolombRuler(bool share, GolombRuler& s)
-            : IntMinimizeScript(share,s) {
+            : IntMinimizeScript(share,s), bound(s.bound) {
         m.update(*this, share, s.m);
     }
     // Copy during cloning
@@ -86,7 +102,20 @@ int main(int argc, char* argv[]) {
     SizeOptions opt("GolombRuler");
     opt.solutions(0);
     opt.size(10);
+    opt.search(GolombRuler::SEARCH_BAB);
+    opt.search(GolombRuler::SEARCH_BAB, "bab", "branch-and-bound");
+    opt.search(GolombRuler::SEARCH_PARALLEL, "parallel", "-threads workers sharing the best length");
     opt.parse(argc,argv);
-    IntMinimizeScript::run<GolombRuler,BAB,SizeOptions>(opt);
+    if (opt.search() == GolombRuler::SEARCH_PARALLEL)
+        parallelbab<GolombRuler>(opt, true);
+    else
+        IntMinimizeScript::run<GolombRuler,BAB,SizeOptions>(opt);
+
+    /**
+     * Example cmd to solve:
+     * ./bin/golomb_rulers 10
+     * ./bin/golomb_rulers -mode stat -threads 0 -c_d 16 11
+     * ./bin/golomb_rulers -search parallel -threads 8 13
+     */
     return 0;
 }
\ No newline at end of file
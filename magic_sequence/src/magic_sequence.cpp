@@ -103,6 +103,7 @@ int main(int argc, char *argv[]) {
      * ./bin/magic_sequence -mode solution -ipl speed -solutions 0
      * ./bin/magic_sequence -mode time -ipl def -solutions 0
      * ./bin/magic_sequence -mode stat -ipl memory -solutions 0
+     * ./bin/magic_sequence -mode stat -threads 4 -c_d 16 -solutions 0
      *
      * or with default (4, solution, def, 1):
      * ./bin/magic_sequence
@@ -8,30 +8,38 @@
 using namespace Gecode;
 using namespace Gecode::Int;
 
-// The exactly propagator
+// The exactly propagator. With dom it subscribes to domain events of seq, since a hole at y changes the count, and
+// once z is saturated y is removed from (or assigned to) the unassigned variables. Propagation then runs to fixpoint.
 class Exactly : public Propagator {
 protected:
     ViewArray<IntView> seq;
     IntView z;
     int y;
+    bool dom;
+
+    // Propagation condition of seq
+    PropCond pc(void) const {
+        return dom ? PC_INT_DOM : PC_INT_BND;
+    }
 
 public:
     // Create propagator and initialize
-    Exactly(Home home, ViewArray<IntView> &seq0, IntView z0, int y0) :
+    Exactly(Home home, ViewArray<IntView> &seq0, IntView z0, int y0, bool dom0) :
     //Initialize variables
             Propagator(home),
             seq(seq0),
             z(z0),
-            y(y0) {
+            y(y0),
+            dom(dom0) {
         //Subscription controls the execution of hte propagator
-        seq.subscribe(home, *this, PC_INT_BND);
+        seq.subscribe(home, *this, pc());
         z.subscribe(home, *this, PC_INT_BND);
     }
 
     // Post exactly propagator. Post function decides whether propagation is necessary and then creates the propagator
     // if needed
-    static ExecStatus post(Home home, ViewArray<IntView> &seq, IntView &z, int y) {
-        (void) new(home) Exactly(home, seq, z, y);
+    static ExecStatus post(Home home, ViewArray<IntView> &seq, IntView &z, int y, bool dom = false) {
+        (void) new(home) Exactly(home, seq, z, y, dom);
         return ES_OK;
     }
 
@@ -41,6 +49,7 @@ public:
         seq.update(home, share, p.seq);
         z.update(home, share, p.z);
         y = p.y;
+        dom = p.dom;
     }
 
     // Create copy during cloning
@@ -50,7 +59,7 @@ public:
 
     // Re-schedule function after propagator has been re-enabled
     virtual void reschedule(Space &home) {
-        seq.reschedule(home, *this, PC_INT_BND);
+        seq.reschedule(home, *this, pc());
         z.reschedule(home, *this, PC_INT_BND);
     }
 
@@ -61,67 +70,438 @@ public:
 
     // Perform propagation
     virtual ExecStatus propagate(Space &home, const ModEventDelta &) {
-        int assigned = 0;
-        int countInDomain = 0;
-        int countAssignedToY = 0;
-        for (int i = 0; i < seq.size(); ++i) {
-            if (seq[i].assigned())
-                assigned++;
-            if (seq[i].in(y))
-                countInDomain++;
-            if (seq[i].assigned() && seq[i].val() == y)
+        bool changed;
+        do {
+            int assigned = 0;
+            int countInDomain = 0;
+            int countAssignedToY = 0;
+            for (int i = 0; i < seq.size(); ++i) {
+                if (seq[i].assigned())
+                    assigned++;
+                if (seq[i].in(y))
+                    countInDomain++;
+                if (seq[i].assigned() && seq[i].val() == y)
+                    countAssignedToY++;
+            }
+            ModEvent lq = z.lq(home, countInDomain);
+            GECODE_ME_CHECK(lq);
+            ModEvent gq = z.gq(home, countAssignedToY);
+            GECODE_ME_CHECK(gq);
+            if(assigned == seq.size())
+                return home.ES_SUBSUMED(*this);
+            if (!dom)
+                return ES_NOFIX;
+
+            //z is saturated, the unassigned variables either all avoid y or all take y
+            changed = false;
+            if (z.assigned() && countInDomain > countAssignedToY &&
+                (z.val() == countAssignedToY || z.val() == countInDomain)) {
+                bool take = z.val() == countInDomain;
+                for (int i = 0; i < seq.size(); ++i) {
+                    if (!seq[i].assigned() && seq[i].in(y))
+                        GECODE_ME_CHECK(take ? seq[i].eq(home, y) : seq[i].nq(home, y));
+                }
+                changed = true;
+            }
+            //z can be one of the variables of seq, then pruning it can change the counts
+            changed = changed || me_modified(lq) || me_modified(gq);
+        } while (changed);
+        return ES_FIX;
+    }
+
+    // Dispose propagator and return its size (dispose works as garbage collection, must cancel subscription first).
+    virtual size_t dispose(Space &home) {
+        seq.cancel(home, *this, pc());
+        z.cancel(home, *this, PC_INT_BND);
+        (void) Propagator::dispose(home);
+        return sizeof(*this);
+    }
+};
+
+// The incremental exactly propagator, keeps the counts of Exactly up to date with one advisor per variable of seq
+class ExactlyIncremental : public Propagator {
+protected:
+    // Advisor of a single variable of seq
+    class Element : public Advisor {
+    public:
+        // Index of the variable
+        int i;
+        // Whether y was in the domain of the variable, and whether the variable was assigned, when last counted
+        bool in, fixed;
+
+        // Create advisor and initialize
+        Element(Space &home, Propagator &p, Council<Element> &c, int i0, bool in0, bool fixed0)
+                : Advisor(home, p, c), i(i0), in(in0), fixed(fixed0) {}
+
+        // Copy constructor during cloning
+        Element(Space &home, bool share, Element &a)
+                : Advisor(home, share, a), i(a.i), in(a.in), fixed(a.fixed) {}
+    };
+
+    ViewArray<IntView> seq;
+    IntView z;
+    int y;
+    // The advisors, one per unassigned variable of seq
+    Council<Element> c;
+    // Number of variables with y in the domain, assigned to y, and assigned
+    int countInDomain;
+    int countAssignedToY;
+    int assigned;
+
+    // Update the counts with the current domain of the advised variable, returns true if a count changed
+    bool update(Element &e) {
+        bool changed = false;
+        if (e.in && !seq[e.i].in(y)) {
+            e.in = false;
+            countInDomain--;
+            changed = true;
+        }
+        if (!e.fixed && seq[e.i].assigned()) {
+            e.fixed = true;
+            assigned++;
+            if (seq[e.i].val() == y)
                 countAssignedToY++;
+            changed = true;
+        }
+        return changed;
+    }
+
+public:
+    // Create propagator and initialize the counts
+    ExactlyIncremental(Home home, ViewArray<IntView> &seq0, IntView z0, int y0) :
+            Propagator(home),
+            seq(seq0),
+            z(z0),
+            y(y0),
+            c(home),
+            countInDomain(0),
+            countAssignedToY(0),
+            assigned(0) {
+        for (int i = 0; i < seq.size(); ++i) {
+            bool in = seq[i].in(y);
+            bool fixed = seq[i].assigned();
+            countInDomain += in ? 1 : 0;
+            countAssignedToY += (fixed && seq[i].val() == y) ? 1 : 0;
+            assigned += fixed ? 1 : 0;
+            if (!fixed) {
+                Element *a = new(home) Element(home, *this, c, i, in, fixed);
+                seq[i].subscribe(home, *a);
+            }
+        }
+        z.subscribe(home, *this, PC_INT_BND);
+    }
+
+    // Post incremental exactly propagator
+    static ExecStatus post(Home home, ViewArray<IntView> &seq, IntView &z, int y) {
+        (void) new(home) ExactlyIncremental(home, seq, z, y);
+        return ES_OK;
+    }
+
+    // Copy constructor during cloning
+    ExactlyIncremental(Space &home, bool share, ExactlyIncremental &p)
+            : Propagator(home, share, p), y(p.y), countInDomain(p.countInDomain),
+              countAssignedToY(p.countAssignedToY), assigned(p.assigned) {
+        seq.update(home, share, p.seq);
+        z.update(home, share, p.z);
+        c.update(home, share, p.c);
+    }
+
+    // Create copy during cloning
+    virtual Propagator *copy(Space &home, bool share) {
+        return new(home) ExactlyIncremental(home, share, *this);
+    }
+
+    // Re-schedule function after propagator has been re-enabled, modifications while disabled were not advised
+    virtual void reschedule(Space &home) {
+        for (Advisors<Element> as(c); as(); ++as)
+            update(as.advisor());
+        z.reschedule(home, *this, PC_INT_BND);
+        IntView::schedule(home, *this, ME_INT_BND);
+    }
+
+    // Return cost (constant, the counts are maintained by the advisors)
+    virtual PropCost cost(const Space &, const ModEventDelta &) const {
+        return PropCost::unary(PropCost::LO);
+    }
+
+    // Update the counts, only schedule the propagator if one of them changed
+    virtual ExecStatus advise(Space &home, Advisor &a, const Delta &) {
+        Element &e = static_cast<Element &>(a);
+        bool changed = update(e);
+        // An assigned variable is folded into the counts for good, so clones do not carry its advisor
+        if (e.fixed) {
+            seq[e.i].cancel(home, e);
+            return changed ? home.ES_NOFIX_DISPOSE(c, e) : home.ES_FIX_DISPOSE(c, e);
         }
+        return changed ? ES_NOFIX : ES_FIX;
+    }
+
+    // Perform propagation
+    virtual ExecStatus propagate(Space &home, const ModEventDelta &) {
+        int inDomain = countInDomain;
+        int assignedToY = countAssignedToY;
         GECODE_ME_CHECK(z.lq(home, countInDomain));
         GECODE_ME_CHECK(z.gq(home, countAssignedToY));
-        if(assigned == seq.size())
+        if (assigned == seq.size())
             return home.ES_SUBSUMED(*this);
-        return ES_NOFIX;
+        //The counts only change when an advisor runs, which schedules the propagator again. The exception is z being
+        //a variable of seq (as in the magic sequence), then tightening z can change the counts right here.
+        return (countInDomain == inDomain && countAssignedToY == assignedToY) ? ES_FIX : ES_NOFIX;
     }
 
-    // Dispose propagator and return its size (dispose works as garbage collection, must cancel subscription first).
+    // Dispose propagator and return its size, the advisors are cancelled first
     virtual size_t dispose(Space &home) {
-        seq.cancel(home, *this, PC_INT_BND);
+        for (Advisors<Element> as(c); as(); ++as)
+            seq[as.advisor().i].cancel(home, as.advisor());
+        c.dispose(home);
         z.cancel(home, *this, PC_INT_BND);
         (void) Propagator::dispose(home);
         return sizeof(*this);
     }
 };
 
-void exactly(Space &home, const IntVarArgs &seq, const IntVar z, const int y) {
+// Exactly propagator that is posted
+enum ExactlyAlgorithm {
+    EXACTLY_RESCAN, //Exactly, rescans seq on every propagation
+    EXACTLY_ADVISOR //ExactlyIncremental, counts maintained by advisors
+};
+
+void exactly(Space &home, const IntVarArgs &seq, const IntVar z, const int y,
+             ExactlyAlgorithm algorithm = EXACTLY_RESCAN, IntPropLevel ipl = IPL_DEF) {
     // Never post a propagator in a failed space
     if (home.failed()) return;
     // Set up array of views for the coordinates
     ViewArray<IntView> vseq(home, seq);
     IntView vz(z);
     // If posting failed, fail space
-    if (Exactly::post(home, vseq, vz, y) != ES_OK)
+    ExecStatus status = algorithm == EXACTLY_ADVISOR ? ExactlyIncremental::post(home, vseq, vz, y)
+                                                     : Exactly::post(home, vseq, vz, y, ipl == IPL_DOM);
+    if (status != ES_OK)
         home.fail();
 }
 
 
+// The cardinality propagator, c[v] is the number of occurrences of the value v in x for all v in [0, c.size()-1].
+// One propagator owns all value/count pairs, instead of one Exactly per value each subscribed to all of x. Per
+// propagation the occurrences are counted from the domain ranges of x with a difference array (linear memory), then:
+// - c[v] is bounded by the number of variables assigned to v and the number of variables with v in the domain
+// - the implied constraint sum(c) = x.size() bounds each c[v] by the bounds of the other counts
+// - a value whose count is saturated is removed from the unassigned variables
+// - a value whose count needs every variable with v in the domain is assigned to them
+class Cardinality : public Propagator {
+protected:
+    ViewArray<IntView> x;
+    ViewArray<IntView> c;
+
+public:
+    // Create propagator and initialize
+    Cardinality(Home home, ViewArray<IntView> &x0, ViewArray<IntView> &c0) : Propagator(home), x(x0), c(c0) {
+        x.subscribe(home, *this, PC_INT_DOM);
+        c.subscribe(home, *this, PC_INT_BND);
+    }
+
+    // Post cardinality propagator, restricts x to the values and c to the possible counts
+    static ExecStatus post(Home home, ViewArray<IntView> &x, ViewArray<IntView> &c) {
+        for (int i = 0; i < x.size(); ++i) {
+            GECODE_ME_CHECK(x[i].gq(home, 0));
+            GECODE_ME_CHECK(x[i].lq(home, c.size() - 1));
+        }
+        for (int v = 0; v < c.size(); ++v) {
+            GECODE_ME_CHECK(c[v].gq(home, 0));
+            GECODE_ME_CHECK(c[v].lq(home, x.size()));
+        }
+        (void) new(home) Cardinality(home, x, c);
+        return ES_OK;
+    }
+
+    // Copy constructor during cloning
+    Cardinality(Space &home, bool share, Cardinality &p) : Propagator(home, share, p) {
+        x.update(home, share, p.x);
+        c.update(home, share, p.c);
+    }
+
+    // Create copy during cloning
+    virtual Propagator *copy(Space &home, bool share) {
+        return new(home) Cardinality(home, share, *this);
+    }
+
+    // Re-schedule function after propagator has been re-enabled
+    virtual void reschedule(Space &home) {
+        x.reschedule(home, *this, PC_INT_DOM);
+        c.reschedule(home, *this, PC_INT_BND);
+    }
+
+    // Return cost (linear in the size of the domains, quadratic in the worst case)
+    virtual PropCost cost(const Space &, const ModEventDelta &) const {
+        return PropCost::quadratic(PropCost::LO, x.size() + c.size());
+    }
+
+    // Perform propagation
+    virtual ExecStatus propagate(Space &home, const ModEventDelta &) {
+        const int m = c.size();
+        Region r(home);
+        // Number of variables with v in the domain (difference array until summed up) and assigned to v
+        int *inDomain = r.alloc<int>(m + 1);
+        int *assignedTo = r.alloc<int>(m);
+        for (int v = 0; v <= m; ++v)
+            inDomain[v] = 0;
+        for (int v = 0; v < m; ++v)
+            assignedTo[v] = 0;
+        int assigned = 0;
+        for (int i = 0; i < x.size(); ++i) {
+            for (ViewRanges<IntView> rg(x[i]); rg(); ++rg) {
+                inDomain[rg.min()]++;
+                inDomain[rg.max() + 1]--;
+            }
+            if (x[i].assigned()) {
+                assignedTo[x[i].val()]++;
+                assigned++;
+            }
+        }
+        for (int v = 1; v < m; ++v)
+            inDomain[v] += inDomain[v - 1];
+
+        // Bounds of the counts from the occurrences
+        for (int v = 0; v < m; ++v) {
+            GECODE_ME_CHECK(c[v].lq(home, inDomain[v]));
+            GECODE_ME_CHECK(c[v].gq(home, assignedTo[v]));
+        }
+
+        // Bounds of the counts from sum(c) = x.size()
+        long int minSum = 0, maxSum = 0;
+        for (int v = 0; v < m; ++v) {
+            minSum += c[v].min();
+            maxSum += c[v].max();
+        }
+        if (minSum > x.size() || maxSum < x.size())
+            return ES_FAILED;
+        for (int v = 0; v < m; ++v) {
+            int lo = c[v].min(), hi = c[v].max();
+            GECODE_ME_CHECK(c[v].lq(home, static_cast<int>(x.size() - (minSum - lo))));
+            GECODE_ME_CHECK(c[v].gq(home, static_cast<int>(x.size() - (maxSum - hi))));
+        }
+
+        // Saturated and forced values, pruned in one pass over the unassigned variables
+        bool prune = false;
+        for (int v = 0; v < m; ++v)
+            prune = prune || (inDomain[v] > assignedTo[v] &&
+                              (c[v].max() == assignedTo[v] || c[v].min() == inDomain[v]));
+        if (prune) {
+            int *remove = r.alloc<int>(m);
+            for (int i = 0; i < x.size(); ++i) {
+                if (x[i].assigned())
+                    continue;
+                int nRemove = 0;
+                int force = -1;
+                for (ViewValues<IntView> val(x[i]); val(); ++val) {
+                    int v = val.val();
+                    if (c[v].max() == assignedTo[v])
+                        remove[nRemove++] = v;
+                    else if (c[v].min() == inDomain[v]) {
+                        //two values that need this variable
+                        if (force >= 0)
+                            return ES_FAILED;
+                        force = v;
+                    }
+                }
+                if (force >= 0) {
+                    GECODE_ME_CHECK(x[i].eq(home, force));
+                } else {
+                    for (int k = 0; k < nRemove; ++k)
+                        GECODE_ME_CHECK(x[i].nq(home, remove[k]));
+                }
+            }
+        }
+
+        if (assigned == x.size() && c.assigned())
+            return home.ES_SUBSUMED(*this);
+        return ES_NOFIX;
+    }
+
+    // Dispose propagator and return its size
+    virtual size_t dispose(Space &home) {
+        x.cancel(home, *this, PC_INT_DOM);
+        c.cancel(home, *this, PC_INT_BND);
+        (void) Propagator::dispose(home);
+        return sizeof(*this);
+    }
+};
+
+void cardinality(Space &home, const IntVarArgs &x, const IntVarArgs &c) {
+    // Never post a propagator in a failed space
+    if (home.failed()) return;
+    ViewArray<IntView> vx(home, x);
+    ViewArray<IntView> vc(home, c);
+    // If posting failed, fail space
+    if (Cardinality::post(home, vx, vc) != ES_OK)
+        home.fail();
+}
+
 #include <gecode/driver.hh>
 #include <gecode/int.hh>
 #include <gecode/minimodel.hh>
+#include "../../common/options.hh"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 using namespace Gecode;
 
+/**
+ * SizeOptions with a range of sizes, -from n -to m solves every size in [n,m]
+ */
+class RangeSizeOptions : public SizeOptions {
+private:
+    Driver::UnsignedIntOption _from;
+    Driver::UnsignedIntOption _to;
+public:
+    RangeSizeOptions(const char *e) :
+            SizeOptions(e),
+            _from("-from", "first size of the range", 4),
+            _to("-to", "last size of the range, 0 solves only the size", 0) {
+        add(_from);
+        add(_to);
+    }
+    unsigned int from(void) const {
+        return _from.value();
+    }
+    unsigned int to(void) const {
+        return _to.value();
+    }
+};
+
 class MagicSequence : public Script {
 
 public:
+    //Propagation of the exactly constraints
+    enum {
+        PROP_RESCAN, //Exactly propagator rescanning the sequence
+        PROP_ADVISOR, //incremental advisor-based Exactly propagator
+        PROP_CARDINALITY //single cardinality propagator for all values
+    };
     const int n;
     IntVarArray seq;
 
-    MagicSequence(const SizeOptions &opt) :
+    MagicSequence(const SizeOptions &opt) : MagicSequence(opt, opt.size()) {}
+
+    MagicSequence(const SizeOptions &opt, int n0) :
             Script(opt),
-            n(opt.size()),
+            n(n0),
             seq(*this, n, 0, n - 1) {
 
         /**
          * Basic constraint for magic sequence
          */
-        for (int i = 0; i < n; ++i) {
-            exactly(*this, seq, seq[i], i);
+        if (opt.propagation() == PROP_CARDINALITY) {
+            cardinality(*this, seq, seq);
+        } else {
+            for (int i = 0; i < n; ++i) {
+                exactly(*this, seq, seq[i], i,
+                        opt.propagation() == PROP_ADVISOR ? EXACTLY_ADVISOR : EXACTLY_RESCAN, opt.ipl());
+            }
         }
 
         /**
@@ -162,6 +542,57 @@ public:
     }
 };
 
+/**
+ * Range mode, solves every size in [-from, -to] in one process on a pool of -threads workers. A worker takes the next
+ * size, searches for -solutions solutions (0 for all) with a sequential DFS engine and the statistics of the size are
+ * written as a CSV row. Rows are written in order of the size as soon as all smaller sizes are done.
+ * Every size gets its own space and engine, only the thread pool is shared: the variables, the Exactly propagators and
+ * their advisors all depend on n, so there is no propagated state to carry from one size to the next.
+ *
+ * @param opt
+ */
+void range(const RangeSizeOptions &opt) {
+    const int from = std::max(1, static_cast<int>(opt.from()));
+    const int to = opt.to();
+    std::atomic<int> next(from);
+    std::mutex mutex;
+    std::vector<std::string> rows(std::max(0, to - from + 1));
+    int written = 0;
+
+    std::cout << "n,solutions,runtime_ms,nodes,failures,propagations,peak_depth" << std::endl;
+    std::vector<std::thread> workers;
+    for (unsigned int w = 0; w < threads(opt); ++w) {
+        workers.push_back(std::thread([&]() {
+            for (int n = next++; n <= to; n = next++) {
+                Support::Timer timer;
+                timer.start();
+                Search::Options so = searchOptions(opt);
+                so.threads = 1;
+                so.clone = false;
+                DFS<MagicSequence> e(new MagicSequence(opt, n), so);
+                unsigned long int solutions = 0;
+                while (MagicSequence *s = e.next()) {
+                    delete s;
+                    if (++solutions == opt.solutions())
+                        break;
+                }
+                double time = timer.stop();
+                Search::Statistics stat = e.statistics();
+                std::ostringstream row;
+                row << n << "," << solutions << "," << time << "," << stat.node << "," << stat.fail << ","
+                    << stat.propagate << "," << stat.depth;
+
+                std::lock_guard<std::mutex> lock(mutex);
+                rows[n - from] = row.str();
+                while (written < static_cast<int>(rows.size()) && !rows[written].empty())
+                    std::cout << rows[written++] << std::endl;
+            }
+        }));
+    }
+    for (unsigned int w = 0; w < workers.size(); ++w)
+        workers[w].join();
+}
+
 /**
  * Program entrypoint, parses commandline options and initializes search engine with root-node.
  * @param argc
@@ -171,7 +602,7 @@ public:
 int main(int argc, char *argv[]) {
 
     //Commandline options
-    SizeOptions opt("MagicSequence");
+    RangeSizeOptions opt("MagicSequence");
 
     //Default options
     opt.solutions(0);
@@ -179,14 +610,21 @@ int main(int argc, char *argv[]) {
     opt.size(100); //nxn board
     opt.mode(ScriptMode::SM_SOLUTION);
     opt.ipl(IPL_DEF);
+    opt.propagation(MagicSequence::PROP_RESCAN);
+    opt.propagation(MagicSequence::PROP_RESCAN, "rescan", "exactly propagator rescanning the sequence");
+    opt.propagation(MagicSequence::PROP_ADVISOR, "advisor", "incremental exactly propagator with advisors");
+    opt.propagation(MagicSequence::PROP_CARDINALITY, "gcc", "single cardinality propagator for all values");
     opt.parse(argc, argv);
 
 
     //parse cmd (potentially overwrite default options)
     opt.parse(argc, argv);
 
-    //run script with DFS engine
-    Script::run<MagicSequence, DFS, SizeOptions>(opt);
+    //solve every size of the range, or a single script with DFS engine
+    if (opt.to() > 0)
+        range(opt);
+    else
+        Script::run<MagicSequence, DFS, RangeSizeOptions>(opt);
 
     /**
      * Example cmd to solve:
@@ -194,6 +632,11 @@ int main(int argc, char *argv[]) {
      * ./bin/magic_sequence -mode solution -ipl speed -solutions 0
      * ./bin/magic_sequence -mode time -ipl def -solutions 0
      * ./bin/magic_sequence -mode stat -ipl memory -solutions 0
+     * ./bin/magic_sequence -mode stat -threads 4 -c_d 16 -solutions 0
+     * ./bin/magic_sequence -mode stat -propagation advisor -solutions 1 1000
+     * ./bin/magic_sequence -mode stat -propagation gcc -solutions 1 1000
+     * ./bin/magic_sequence -mode stat -propagation rescan -ipl dom -solutions 0 100
+     * ./bin/magic_sequence_with_prop -propagation gcc -solutions 1 -from 4 -to 2000 -threads 0 > sizes.csv
      *
      * or with default (4, solution, def, 1):
      * ./bin/magic_sequence
@@ -134,6 +134,12 @@ int main(int argc, char *argv[]) {
     opt.parse(argc, argv);
     std::cout << "size:" <<  opt.size();
     Script::run<Queens, DFS, SizeOptions>(opt);
+
+    /**
+     * Example cmd to solve:
+     * ./bin/queens -propagation distinct 10
+     * ./bin/queens -mode stat -threads 0 -c_d 16 12
+     */
 /*
     Queens* m = new Queens(opt);
     Gist::Print<Queens> p("Print solution"); //Call print function when clicking on a node (a computation space in the tree)
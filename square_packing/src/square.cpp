@@ -15,12 +15,53 @@
 #include <gecode/driver.hh>
 #include <gecode/int.hh>
 #include <gecode/minimodel.hh>
+#include "../../common/options.hh"
+#include "../../common/cumulative.hh"
+#include <atomic>
+#include <climits>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 using namespace Gecode;
 
+/**
+ * SubproblemSizeOptions for solving the subproblems of the enclosing square size s in parallel.
+ */
+class SubproblemSizeOptions : public SizeOptions {
+private:
+    Driver::UnsignedIntOption _subproblems;
+public :
+    SubproblemSizeOptions(const char *e) :
+            SizeOptions(e),
+            _subproblems("-subproblems", "Number of threads solving one s-subproblem each (0 = single search)", 0) {
+        add(_subproblems);
+    }
+
+    void parse(int &argc, char *argv[]) {
+        SizeOptions::parse(argc, argv);
+    }
+
+    unsigned int subproblems(void) const {
+        return _subproblems.value();
+    }
+};
+
 class SquarePacking : public Script {
 
 public:
+    /// Model variants for the cumulative constraint
+    enum {
+        MODEL_DECOMPOSITION, ///< One reified dom-constraint per square and column plus a linear sum per column
+        MODEL_CUMULATIVE     ///< Dedicated cumulative propagator for squares
+    };
+    /// Variable selection of the coordinate branchings
+    enum {
+        BRANCH_SIZE,    ///< Smallest domain first
+        BRANCH_RANDOM,  ///< Smallest domain first, ties broken randomly (for restarts)
+        BRANCH_AFC,     ///< Largest accumulated failure count per domain size
+        BRANCH_ACTIVITY ///< Largest activity per domain size
+    };
     const int n;
     IntVar s;
     IntVarArray xCoords, yCoords;
@@ -83,19 +124,27 @@ public:
          * Redundant constraints to increase propagation, the non-overlapping coordinates implies this constraint.
          * This redundant constraint have very big impact on performance.
          */
-        for (int i = 0; i < s.max(); ++i) {
-            BoolVarArgs colOverlap(*this, n - 1, 0, 1);
-            BoolVarArgs rowOverlap(*this, n - 1, 0, 1);
-            for (int j = 0; j < n - 1; ++j) {
-                dom(*this, xCoords[j], i - size(j) + 1, i, colOverlap[j]);//x <= colIndex < x means overlap
-                dom(*this, yCoords[j], i - size(j) + 1, i, rowOverlap[j]);//y <= rowIndex < y means overlap
+        if (opt.model() == MODEL_CUMULATIVE) {
+            IntArgs sizes(n - 1);
+            for (int i = 0; i < n - 1; i++)
+                sizes[i] = size(i);
+            squarecumulative(*this, xCoords, sizes, s);
+            squarecumulative(*this, yCoords, sizes, s);
+        } else {
+            for (int i = 0; i < s.max(); ++i) {
+                BoolVarArgs colOverlap(*this, n - 1, 0, 1);
+                BoolVarArgs rowOverlap(*this, n - 1, 0, 1);
+                for (int j = 0; j < n - 1; ++j) {
+                    dom(*this, xCoords[j], i - size(j) + 1, i, colOverlap[j]);//x <= colIndex < x means overlap
+                    dom(*this, yCoords[j], i - size(j) + 1, i, rowOverlap[j]);//y <= rowIndex < y means overlap
+                }
+                /**
+                 * sum of the sizes of the squares occupying space at column x must be less than or equal to s.
+                 * sum of the sizes of the squares occupying space at row y must be less than or equal to s.
+                 */
+                rel(*this, sum(IntArgs::create(n - 1, n, -1), colOverlap) <= s, opt.ipl());
+                rel(*this, sum(IntArgs::create(n - 1, n, -1), rowOverlap) <= s, opt.ipl());
             }
-            /**
-             * sum of the sizes of the squares occupying space at column x must be less than or equal to s.
-             * sum of the sizes of the squares occupying space at row y must be less than or equal to s.
-             */
-            rel(*this, sum(IntArgs::create(n - 1, n, -1), colOverlap) <= s, opt.ipl());
-            rel(*this, sum(IntArgs::create(n - 1, n, -1), rowOverlap) <= s, opt.ipl());
         }
 
         /**
@@ -120,8 +169,21 @@ public:
          */
         branch(*this, s, INT_VAL_MIN()); //Branch first on s
         //Try larger squares first, larger squares have smaller domains, try small x,y coords first (left-to-right, bottom-to-top)
-        branch(*this, xCoords, INT_VAR_SIZE_MIN(), INT_VAL_MIN()); //Assign x-coords first
-        branch(*this, yCoords, INT_VAR_SIZE_MIN(), INT_VAL_MIN()); //Assign y-coords second
+        if (opt.branching() == BRANCH_RANDOM) {
+            //Random ties make every restart explore a different tree
+            Rnd r(opt.seed());
+            branch(*this, xCoords, tiebreak(INT_VAR_SIZE_MIN(), INT_VAR_RND(r)), INT_VAL_MIN());
+            branch(*this, yCoords, tiebreak(INT_VAR_SIZE_MIN(), INT_VAR_RND(r)), INT_VAL_MIN());
+        } else if (opt.branching() == BRANCH_AFC) {
+            branch(*this, xCoords, INT_VAR_AFC_SIZE_MAX(opt.decay()), INT_VAL_MIN());
+            branch(*this, yCoords, INT_VAR_AFC_SIZE_MAX(opt.decay()), INT_VAL_MIN());
+        } else if (opt.branching() == BRANCH_ACTIVITY) {
+            branch(*this, xCoords, INT_VAR_ACTIVITY_SIZE_MAX(opt.decay()), INT_VAL_MIN());
+            branch(*this, yCoords, INT_VAR_ACTIVITY_SIZE_MAX(opt.decay()), INT_VAL_MIN());
+        } else {
+            branch(*this, xCoords, INT_VAR_SIZE_MIN(), INT_VAL_MIN()); //Assign x-coords first
+            branch(*this, yCoords, INT_VAR_SIZE_MIN(), INT_VAL_MIN()); //Assign y-coords second
+        }
     }
 
 
@@ -224,6 +286,96 @@ public:
     }
 };
 
+/**
+ * Stop object for a subproblem, stops the search as soon as a smaller s has been shown to be feasible.
+ */
+class SubproblemStop : public Search::Stop {
+private:
+    const std::atomic<int> &best;
+    const int s;
+public:
+    SubproblemStop(const std::atomic<int> &best0, int s0) : best(best0), s(s0) {}
+
+    virtual bool stop(const Search::Statistics &, const Search::Options &) {
+        return best.load() < s;
+    }
+};
+
+/**
+ * Subproblem-parallel search. Branching on s first decomposes the problem into one independent subproblem per
+ * candidate s in [nSquaresArea(), nSquaresStacked(n)], the subproblems are handed out in increasing order of s to a
+ * pool of threads. A thread that finds a solution publishes its s, every subproblem with a larger s is then cancelled
+ * and no new ones are started. The smallest feasible s is the optimum.
+ *
+ * @param opt
+ */
+void subproblems(const SubproblemSizeOptions &opt) {
+    Support::Timer timer;
+    timer.start();
+    SquarePacking *root = new SquarePacking(opt);
+    if (root->status() == SS_FAILED) {
+        std::cout << "No solution found" << std::endl;
+        delete root;
+        return;
+    }
+    //read the bounds before any thread starts cloning the root
+    const int hi = root->s.max();
+    std::atomic<int> next(root->s.min());
+    std::atomic<int> best(INT_MAX);
+    std::mutex mutex;
+    SquarePacking *solution = NULL;
+    Search::Statistics statistics;
+    unsigned long int refuted = 0, cancelled = 0;
+
+    std::vector<std::thread> threads;
+    for (unsigned int w = 0; w < opt.subproblems(); ++w) {
+        threads.push_back(std::thread([&]() {
+            for (int s = next++; s <= hi && s < best.load(); s = next++) {
+                SquarePacking *subproblem;
+                {
+                    //cloning updates the root space, only one thread at a time
+                    std::lock_guard<std::mutex> lock(mutex);
+                    subproblem = static_cast<SquarePacking *>(root->clone(false));
+                }
+                rel(*subproblem, subproblem->s == s);
+                SubproblemStop stop(best, s);
+                Search::Options so = searchOptions(opt, &stop);
+                so.threads = 1;
+                so.clone = false;
+                DFS<SquarePacking> e(subproblem, so);
+                SquarePacking *sol = e.next();
+                std::lock_guard<std::mutex> lock(mutex);
+                statistics += e.statistics();
+                if (sol != NULL && s < best.load()) {
+                    best.store(s);
+                    delete solution;
+                    solution = sol;
+                } else {
+                    delete sol;
+                    if (e.stopped())
+                        cancelled++;
+                    else if (sol == NULL)
+                        refuted++;
+                }
+            }
+        }));
+    }
+    for (unsigned int w = 0; w < threads.size(); ++w)
+        threads[w].join();
+    double time = timer.stop();
+    delete root;
+
+    if (solution == NULL)
+        std::cout << "No solution found" << std::endl;
+    else
+        solution->print(std::cout);
+    std::cout << "Subproblems: " << refuted << " refuted, " << cancelled << " cancelled" << std::endl
+              << "\truntime:      " << time << " ms" << std::endl
+              << "\tnodes:        " << statistics.node << std::endl
+              << "\tfailures:     " << statistics.fail << std::endl;
+    delete solution;
+}
+
 /**
  * Program entrypoint, parses commandline options and initializes search engine with root-node.
  * @param argc
@@ -233,7 +385,7 @@ public:
 int main(int argc, char *argv[]) {
 
     //Commandline options
-    SizeOptions opt("SquarePacking");
+    SubproblemSizeOptions opt("SquarePacking");
 
     //Default options
     opt.solutions(0);//0 means find all solutions.
@@ -241,18 +393,34 @@ int main(int argc, char *argv[]) {
     opt.size(10); //n size
     opt.mode(ScriptMode::SM_SOLUTION); //Solution mode (i.e no GIST) is default
     opt.ipl(IPL_DEF); //Default propagation strength
+    opt.model(SquarePacking::MODEL_DECOMPOSITION);
+    opt.model(SquarePacking::MODEL_DECOMPOSITION, "decomposition", "reified dom-constraints per column and row");
+    opt.model(SquarePacking::MODEL_CUMULATIVE, "cumulative", "cumulative propagator per axis");
+    opt.branching(SquarePacking::BRANCH_SIZE);
+    opt.branching(SquarePacking::BRANCH_SIZE, "size", "smallest domain first");
+    opt.branching(SquarePacking::BRANCH_RANDOM, "random", "smallest domain first with random ties, use with -restart");
+    opt.branching(SquarePacking::BRANCH_AFC, "afc", "largest accumulated failure count, decay with -decay");
+    opt.branching(SquarePacking::BRANCH_ACTIVITY, "activity", "largest activity, decay with -decay");
     opt.parse(argc, argv);
 
 
     //parse cmd (potentially overwrite default options)
     opt.parse(argc, argv);
 
-    //run script with DFS engine
-    Script::run<SquarePacking, DFS, SizeOptions>(opt);
+    //run the s-subproblems in parallel, or a single script with DFS engine (RBS around DFS with -restart)
+    if (opt.subproblems() > 0)
+        subproblems(opt);
+    else
+        Script::run<SquarePacking, DFS, SubproblemSizeOptions>(opt);
 
     /**
      * Example cmd to solve:
      * ./bin/square_packing -solutions 1 15
+     * ./bin/square_packing -subproblems 8 20
+     * ./bin/square_packing -solutions 1 -threads 0 -c_d 16 15
+     * ./bin/square_packing -solutions 1 -branching random -seed 7 -restart luby -restart-scale 100 20
+     * ./bin/square_packing -solutions 1 -branching random -restart geometric -restart-base 1.5 -restart-scale 50 20
+     * ./bin/square_packing -mode stat -solutions 1 -branching activity -decay 0.95 20
      */
     return 0;
 }
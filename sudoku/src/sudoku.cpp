@@ -6,10 +6,197 @@
 #include <gecode/driver.hh>
 #include <gecode/int.hh>
 #include <gecode/minimodel.hh>
+#include "../../common/options.hh"
 #include <gecode/gist.hh>
 #include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace Gecode;
+using namespace Gecode::Int;
+
+/**
+ * All-different propagator for a unit (row, column or square) of a sudoku, the n views take exactly the values 1..n
+ * with n <= 64. Domains are copied into 64-bit masks (bit v-1 for value v) and the following rules are applied to the
+ * masks until none of them prunes anything, then the views are pruned once:
+ * - naked singles, the value of an assigned view is removed from all other views
+ * - hidden singles, a value that fits only one view is assigned to it
+ * - naked pairs, two views with the same two values remove them from all other views
+ * - pigeonhole, the unit fails if some value fits no view
+ */
+class BitDistinct : public Propagator {
+protected:
+    ViewArray<IntView> x;
+
+    static bool single(unsigned long long int m) {
+        return (m & (m - 1)) == 0;
+    }
+
+    //Domain of the view as a mask
+    static unsigned long long int mask(const IntView &v) {
+        unsigned long long int m = 0;
+        for (ViewRanges<IntView> r(v); r(); ++r) {
+            unsigned int w = r.max() - r.min() + 1;
+            m |= (w == 64 ? ~0ULL : (1ULL << w) - 1) << (r.min() - 1);
+        }
+        return m;
+    }
+
+public:
+    // Create propagator and initialize
+    BitDistinct(Home home, ViewArray<IntView> &x0) : Propagator(home), x(x0) {
+        x.subscribe(home, *this, PC_INT_DOM);
+    }
+
+    // Post propagator
+    static ExecStatus post(Home home, ViewArray<IntView> &x) {
+        for (int i = 0; i < x.size(); i++) {
+            GECODE_ME_CHECK(x[i].gq(home, 1));
+            GECODE_ME_CHECK(x[i].lq(home, x.size()));
+        }
+        (void) new(home) BitDistinct(home, x);
+        return ES_OK;
+    }
+
+    // Copy constructor during cloning
+    BitDistinct(Space &home, bool share, BitDistinct &p) : Propagator(home, share, p) {
+        x.update(home, share, p.x);
+    }
+
+    // Create copy during cloning
+    virtual Propagator *copy(Space &home, bool share) {
+        return new(home) BitDistinct(home, share, *this);
+    }
+
+    // Re-schedule function after propagator has been re-enabled
+    virtual void reschedule(Space &home) {
+        x.reschedule(home, *this, PC_INT_DOM);
+    }
+
+    // Cost, naked pairs are quadratic in the worst case
+    virtual PropCost cost(const Space &, const ModEventDelta &) const {
+        return PropCost::quadratic(PropCost::LO, x.size());
+    }
+
+    // Perform propagation
+    virtual ExecStatus propagate(Space &home, const ModEventDelta &) {
+        const int n = x.size();
+        const unsigned long long int all = n == 64 ? ~0ULL : (1ULL << n) - 1;
+        Region r(home);
+        unsigned long long int *d = r.alloc<unsigned long long int>(n);
+        for (int i = 0; i < n; i++)
+            d[i] = mask(x[i]);
+
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            //naked singles
+            unsigned long long int fixed = 0;
+            for (int i = 0; i < n; i++) {
+                if (single(d[i])) {
+                    if (fixed & d[i])
+                        return ES_FAILED;
+                    fixed |= d[i];
+                }
+            }
+            for (int i = 0; i < n; i++) {
+                if (!single(d[i]) && (d[i] & fixed)) {
+                    d[i] &= ~fixed;
+                    if (d[i] == 0)
+                        return ES_FAILED;
+                    changed = true;
+                }
+            }
+            if (changed)
+                continue;
+            //pigeonhole and hidden singles, once are the values that fit some view, twice the values that fit two
+            unsigned long long int once = 0, twice = 0;
+            for (int i = 0; i < n; i++) {
+                twice |= once & d[i];
+                once |= d[i];
+            }
+            if (once != all)
+                return ES_FAILED;
+            unsigned long long int hidden = once & ~twice & ~fixed;
+            for (int i = 0; hidden != 0 && i < n; i++) {
+                if (d[i] & hidden) {
+                    d[i] &= hidden;
+                    //two values that fit only this view
+                    if (!single(d[i]))
+                        return ES_FAILED;
+                    changed = true;
+                }
+            }
+            if (changed)
+                continue;
+            //naked pairs
+            for (int i = 0; i < n; i++) {
+                if (single(d[i]) || !single(d[i] & (d[i] - 1)))
+                    continue;
+                for (int j = i + 1; j < n; j++) {
+                    if (d[j] != d[i])
+                        continue;
+                    for (int k = 0; k < n; k++) {
+                        if (k != i && k != j && (d[k] & d[i])) {
+                            d[k] &= ~d[i];
+                            if (d[k] == 0)
+                                return ES_FAILED;
+                            changed = true;
+                        }
+                    }
+                }
+            }
+        }
+
+        int assigned = 0;
+        for (int i = 0; i < n; i++) {
+            if (single(d[i])) {
+                GECODE_ME_CHECK(x[i].eq(home, __builtin_ctzll(d[i]) + 1));
+                assigned++;
+            } else {
+                for (unsigned long long int removed = mask(x[i]) & ~d[i]; removed != 0; removed &= removed - 1)
+                    GECODE_ME_CHECK(x[i].nq(home, __builtin_ctzll(removed) + 1));
+            }
+        }
+        if (assigned == n)
+            return home.ES_SUBSUMED(*this);
+        return ES_FIX;
+    }
+
+    // Dispose propagator and return its size
+    virtual size_t dispose(Space &home) {
+        x.cancel(home, *this, PC_INT_DOM);
+        (void) Propagator::dispose(home);
+        return sizeof(*this);
+    }
+};
+
+/**
+ * Post function for the bitset all-different propagator, the variables take exactly the values 1..x.size().
+ *
+ * @param home
+ * @param x at most 64 variables
+ */
+void bitdistinct(Space &home, const IntVarArgs &x) {
+    if (x.size() > 64)
+        throw Exception("bitdistinct", "at most 64 variables");
+    // Never post a propagator in a failed space
+    if (home.failed()) return;
+    ViewArray<IntView> vx(home, x);
+    // If posting failed, fail space
+    if (BitDistinct::post(home, vx) != ES_OK)
+        home.fail();
+}
 
 //
 // Help functions for ID2204, Assignment 1, Task 5
@@ -242,11 +429,22 @@ static int examples[][9][9] = {
 class SudokuOptions : public Options {
 private:
     Driver::UnsignedIntOption _sudoku;
+    Driver::UnsignedIntOption _order;
+    Driver::StringValueOption _batch;
+    Driver::BoolOption _latency;
 public :
     SudokuOptions(const char *e) :
             Options(e),
-            _sudoku("-sudoku", "sudoku number [0,17", 0) {
+            _sudoku("-sudoku", "sudoku number [0,17", 0),
+            _order("-order", "order n of the n^2 x n^2 grid [2,7], only 3 has examples, other orders solve the empty grid",
+                   3),
+            _batch("-batch", "solve the puzzles in file, one per line (n^4 characters, 0 or . for blanks), - for stdin"),
+            _latency("-latency", "with -batch, compare per-puzzle latency of cloning the root space against construction",
+                     false) {
         add(_sudoku);
+        add(_order);
+        add(_batch);
+        add(_latency);
     }
     void parse(int &argc, char *argv[]) {
         Options::parse(argc, argv);
@@ -254,6 +452,15 @@ public :
     int sudoku(void) const {
         return _sudoku.value();
     }
+    int order(void) const {
+        return _order.value();
+    }
+    const char *batch(void) const {
+        return _batch.value();
+    }
+    bool latency(void) const {
+        return _latency.value();
+    }
 };
 
 /**
@@ -262,33 +469,68 @@ public :
  */
 class Sudoku : public Script {
 public:
+    //Propagation of the all-different constraints
+    enum {
+        PROP_DISTINCT, //Gecode's distinct with -ipl
+        PROP_BITSET //BitDistinct over 64-bit masks
+    };
+    //Order n, the grid is n^2 x n^2 with n x n squares
+    const int n;
     //One IntVar per position in sudoku
     IntVarArray sudokuPositions;
 
     Sudoku(const SudokuOptions &opt) :
             ScriptBase(opt),
-            sudokuPositions(*this, 9 * 9, 1, 9) {
-
-        Matrix<IntVarArray> sudokuMatrix(sudokuPositions, 9, 9);
-
-        //Add constraints for the pre-filled positions
-        for (int i = 0; i < 9; i++) {
-            for (int j = 0; j < 9; j++) {
-                int value = examples[opt.sudoku()][i][j]; //picked A1
-                if (value != 0) //Found a non-blank
-                    rel(*this, sudokuMatrix(j, i) == value);
+            n(opt.order()),
+            sudokuPositions(*this, n * n * n * n, 1, n * n) {
+
+        Matrix<IntVarArray> sudokuMatrix(sudokuPositions, n * n, n * n);
+
+        //Add constraints for the pre-filled positions, in batch mode they are posted per puzzle with given()
+        if (opt.batch() == NULL && n == 3) {
+            for (int i = 0; i < 9; i++) {
+                for (int j = 0; j < 9; j++) {
+                    int value = examples[opt.sudoku()][i][j]; //picked A1
+                    if (value != 0) //Found a non-blank
+                        rel(*this, sudokuMatrix(j, i) == value);
+                }
             }
         }
 
+        post(opt);
+    }
+
+    //Construct a puzzle from scratch, the line is in the format of given()
+    Sudoku(const SudokuOptions &opt, const std::string &line) :
+            ScriptBase(opt),
+            n(opt.order()),
+            sudokuPositions(*this, n * n * n * n, 1, n * n) {
+        given(line);
+        post(opt);
+    }
+
+    //All-different constraint of one row, column or square
+    void alldifferent(const SudokuOptions &opt, const IntVarArgs &x) {
+        if (opt.propagation() == PROP_BITSET)
+            bitdistinct(*this, x);
+        else
+            distinct(*this, x, opt.ipl());
+    }
+
+    //Distinct constraints and branching
+    void post(const SudokuOptions &opt) {
+        const int N = n * n;
+        Matrix<IntVarArray> sudokuMatrix(sudokuPositions, N, N);
+
         //Distinct row and distinct column constraints
-        for (int i = 0; i < 9; i++) {
-            distinct(*this, sudokuMatrix.row(i), opt.ipl());
-            distinct(*this, sudokuMatrix.col(i), opt.ipl());
+        for (int i = 0; i < N; i++) {
+            alldifferent(opt, sudokuMatrix.row(i));
+            alldifferent(opt, sudokuMatrix.col(i));
         }
-        //Each 3x3 square should have all digits 1-9 constraint
-        for (int i = 0; i < 9; i += 3) {
-            for (int j = 0; j < 9; j += 3) {
-                distinct(*this, sudokuMatrix.slice(i, i + 3, j, j + 3), opt.ipl());
+        //Each nxn square should have all digits 1-n^2 constraint
+        for (int i = 0; i < N; i += n) {
+            for (int j = 0; j < N; j += n) {
+                alldifferent(opt, sudokuMatrix.slice(i, i + n, j, j + n));
             }
         }
 
@@ -297,7 +539,7 @@ public:
     }
 
     //Copy-constructor for backtracking
-    Sudoku(bool share, Sudoku &space) : Script(share, space) {
+    Sudoku(bool share, Sudoku &space) : Script(share, space), n(space.n) {
         sudokuPositions.update(*this, share, space.sudokuPositions);
     }
 
@@ -306,30 +548,332 @@ public:
         return new Sudoku(share, *this);
     }
 
+    //Symbols of the values 1..49 in the line format, blanks are 0 or .
+    static const char *symbols(void) {
+        return "123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmn";
+    }
+
+    /**
+     * Posts the pre-filled positions of a puzzle given as a line of n^4 characters, row by row, 1-9 and then A-Z, a-z
+     * for the values of the pre-filled positions and 0 or . for blanks.
+     *
+     * @param line
+     * @return false if the line is not a puzzle
+     */
+    bool given(const std::string &line) {
+        const int N = n * n;
+        if (line.size() != static_cast<size_t>(N * N))
+            return false;
+        for (int i = 0; i < N * N; i++) {
+            if (line[i] == '0' || line[i] == '.')
+                continue;
+            const char *symbol = strchr(symbols(), line[i]);
+            if (symbol == NULL || symbol - symbols() >= N)
+                return false;
+            rel(*this, sudokuPositions[i], IRT_EQ, static_cast<int>(symbol - symbols()) + 1);
+        }
+        return true;
+    }
+
+    //Solution as a line of n^4 symbols, same format as the input of given()
+    std::string solution(void) const {
+        std::string line(sudokuPositions.size(), '.');
+        for (int i = 0; i < sudokuPositions.size(); i++) {
+            if (sudokuPositions[i].assigned())
+                line[i] = symbols()[sudokuPositions[i].val() - 1];
+        }
+        return line;
+    }
+
     //Print sudokuPositions
     virtual void print(std::ostream &os) const {
-        os << "-------------------------" << std::endl;
-        for (int i = 0; i < 9; i++) {
-            for (int j = 0; j < 3; j++) {
-                os << "|" << sudokuPositions[i * 9 + j];
-            }
-            os << "  ";
-            for (int j = 3; j < 6; j++) {
-                os << "|" << sudokuPositions[i * 9 + j];
-            }
-            os << "|  ";
-            for (int j = 6; j < 9; j++) {
-                os << "|" << sudokuPositions[i * 9 + j];
+        const int N = n * n;
+        const std::string line(N * 2 + 3 * (n - 1) + 7, '-');
+        os << line << std::endl;
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; j < N; j++) {
+                if (j > 0 && j % n == 0)
+                    os << "|  ";
+                os << "|" << sudokuPositions[i * N + j];
             }
             os << "|" << std::endl;
-            if (i == 2 || i == 5)
+            if ((i + 1) % n == 0 && i + 1 < N)
                 os << std::endl;
+        }
+        os << line << std::endl;
+    }
+};
 
+/**
+ * Source of puzzles in batch mode, one puzzle per line. A file is memory-mapped, - reads from stdin. Lines are handed
+ * out in chunks so that the workers rarely contend for the lock, empty lines and lines starting with # are skipped.
+ */
+class PuzzleSource {
+private:
+    std::mutex mutex;
+    int fd;
+    char *data;
+    size_t size, pos;
+    size_t count;
+public:
+    PuzzleSource(const char *file) : fd(-1), data(NULL), size(0), pos(0), count(0) {
+        if (std::string(file) == "-")
+            return;
+        fd = open(file, O_RDONLY);
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st) < 0) {
+            std::cerr << "Could not open " << file << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        size = static_cast<size_t>(st.st_size);
+        if (size > 0) {
+            data = static_cast<char *>(mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0));
+            if (data == MAP_FAILED) {
+                std::cerr << "Could not map " << file << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            madvise(data, size, MADV_SEQUENTIAL);
+        }
+    }
+
+    ~PuzzleSource(void) {
+        if (data != NULL)
+            munmap(data, size);
+        if (fd >= 0)
+            close(fd);
+    }
+
+    /**
+     * Fetches the next chunk of puzzles.
+     *
+     * @param lines cleared and filled with at most n puzzles
+     * @param n
+     * @return index of the first puzzle of the chunk
+     */
+    size_t next(std::vector<std::string> &lines, size_t n) {
+        std::lock_guard<std::mutex> lock(mutex);
+        lines.clear();
+        std::string line;
+        while (lines.size() < n && read(line)) {
+            if (!line.empty() && line[line.size() - 1] == '\r')
+                line.erase(line.size() - 1);
+            if (!line.empty() && line[0] != '#')
+                lines.push_back(line);
+        }
+        size_t first = count;
+        count += lines.size();
+        return first;
+    }
+
+private:
+    bool read(std::string &line) {
+        if (fd < 0)
+            return static_cast<bool>(std::getline(std::cin, line));
+        if (pos >= size)
+            return false;
+        const char *begin = data + pos;
+        const char *end = static_cast<const char *>(memchr(begin, '\n', size - pos));
+        if (end == NULL)
+            end = data + size;
+        line.assign(begin, end);
+        pos = end - data + 1;
+        return true;
+    }
+};
+
+/**
+ * Writes the solutions of batch mode in the order of the input while the workers finish chunks out of order. A chunk
+ * that is ahead of the output is kept until the chunks before it are written.
+ */
+class SolutionWriter {
+private:
+    std::mutex mutex;
+    std::ostream &os;
+    size_t written;
+    std::map<size_t, std::vector<std::string> > pending;
+public:
+    SolutionWriter(std::ostream &os0) : os(os0), written(0) {}
+
+    void write(size_t first, std::vector<std::string> &solutions) {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending[first].swap(solutions);
+        while (!pending.empty() && pending.begin()->first == written) {
+            std::vector<std::string> &chunk = pending.begin()->second;
+            for (size_t i = 0; i < chunk.size(); i++)
+                os << chunk[i] << '\n';
+            written += chunk.size();
+            pending.erase(pending.begin());
         }
-        os << "-------------------------" << std::endl;
+        os.flush();
     }
 };
 
+/**
+ * Solves a single puzzle with a sequential DFS engine, the engine takes ownership of the puzzle.
+ *
+ * @param puzzle
+ * @param opt
+ * @param stat engine statistics are added to stat
+ * @return solution line, "no solution" if the puzzle is unsolvable
+ */
+std::string solve(Sudoku *puzzle, const SudokuOptions &opt, Search::Statistics &stat) {
+    Search::Options so = searchOptions(opt);
+    so.threads = 1;
+    so.clone = false;
+    DFS<Sudoku> e(puzzle, so);
+    Sudoku *sol = e.next();
+    stat += e.statistics();
+    if (sol == NULL)
+        return "no solution";
+    std::string line = sol->solution();
+    delete sol;
+    return line;
+}
+
+/**
+ * Root space of batch mode, the row, column and square constraints are posted and propagated once. A puzzle is a
+ * clone of the root with its pre-filled positions posted, which skips posting the 27 distinct constraints and
+ * the initial propagation of the empty board for every puzzle.
+ *
+ * @param opt
+ * @return
+ */
+Sudoku *propagatedRoot(const SudokuOptions &opt) {
+    Sudoku *root = new Sudoku(opt);
+    root->status();
+    return root;
+}
+
+/**
+ * Batch mode, solves the puzzles read by PuzzleSource on a pool of -threads workers. Every worker builds one root
+ * space as a clone of the propagatedRoot() and clones it per puzzle, so only the pre-filled positions are posted
+ * per puzzle. Each puzzle is solved by a sequential DFS engine, the solution (or "no solution"/"invalid") is
+ * written to stdout as one line per puzzle in input order, throughput statistics are written to stderr.
+ *
+ * @param opt
+ */
+void batch(const SudokuOptions &opt) {
+    const size_t chunk = 64;
+    Support::Timer timer;
+    timer.start();
+    PuzzleSource source(opt.batch());
+    SolutionWriter writer(std::cout);
+    Sudoku *shared = propagatedRoot(opt);
+    std::mutex mutex;
+    Search::Statistics statistics;
+    unsigned long int solved = 0, unsolvable = 0, invalid = 0;
+
+    std::vector<std::thread> workers;
+    for (unsigned int w = 0; w < threads(opt); ++w) {
+        workers.push_back(std::thread([&]() {
+            Sudoku *root;
+            {
+                //cloning updates the shared root, only one thread at a time
+                std::lock_guard<std::mutex> lock(mutex);
+                root = static_cast<Sudoku *>(shared->clone(false));
+            }
+            Search::Statistics stat;
+            unsigned long int s = 0, u = 0, i = 0;
+            std::vector<std::string> lines, solutions;
+            for (size_t first = source.next(lines, chunk); !lines.empty(); first = source.next(lines, chunk)) {
+                solutions.clear();
+                for (size_t l = 0; l < lines.size(); l++) {
+                    Sudoku *puzzle = static_cast<Sudoku *>(root->clone(false));
+                    if (!puzzle->given(lines[l])) {
+                        delete puzzle;
+                        solutions.push_back("invalid");
+                        i++;
+                        continue;
+                    }
+                    solutions.push_back(solve(puzzle, opt, stat));
+                    if (solutions.back() == "no solution")
+                        u++;
+                    else
+                        s++;
+                }
+                writer.write(first, solutions);
+            }
+            delete root;
+            std::lock_guard<std::mutex> lock(mutex);
+            statistics += stat;
+            solved += s;
+            unsolvable += u;
+            invalid += i;
+        }));
+    }
+    for (unsigned int w = 0; w < workers.size(); ++w)
+        workers[w].join();
+    double time = timer.stop();
+    delete shared;
+
+    unsigned long int puzzles = solved + unsolvable + invalid;
+    std::cerr << "Batch: " << puzzles << " puzzles, " << solved << " solved, " << unsolvable << " unsolvable, "
+              << invalid << " invalid" << std::endl
+              << "\tthreads:      " << workers.size() << std::endl
+              << "\truntime:      " << time << " ms" << std::endl
+              << "\tthroughput:   " << (time > 0 ? puzzles / (time / 1000.0) : 0) << " puzzles/s" << std::endl
+              << "\tnodes:        " << statistics.node << std::endl
+              << "\tfailures:     " << statistics.fail << std::endl;
+}
+
+/**
+ * Latency benchmark of batch mode, every puzzle of -batch is solved twice on one thread: constructed from scratch
+ * (givens, distinct constraints, propagation of the whole board) and as a clone of the propagatedRoot(). The
+ * per-puzzle latency from construction/cloning to the first solution is compared, with the nodes and failures of each
+ * path, solutions are not written.
+ *
+ * @param opt
+ */
+void latency(const SudokuOptions &opt) {
+    PuzzleSource source(opt.batch());
+    Sudoku *shared = propagatedRoot(opt);
+    //Per path, equal nodes and failures show that both paths search the same tree
+    Search::Statistics constructedStatistics, clonedStatistics;
+    std::vector<double> constructed, cloned;
+    unsigned long int invalid = 0;
+    std::vector<std::string> lines;
+    Support::Timer timer;
+
+    for (source.next(lines, 64); !lines.empty(); source.next(lines, 64)) {
+        for (size_t l = 0; l < lines.size(); l++) {
+            timer.start();
+            Sudoku *puzzle = static_cast<Sudoku *>(shared->clone(false));
+            if (!puzzle->given(lines[l])) {
+                delete puzzle;
+                invalid++;
+                continue;
+            }
+            std::string clone = solve(puzzle, opt, clonedStatistics);
+            cloned.push_back(timer.stop());
+
+            timer.start();
+            puzzle = new Sudoku(opt, lines[l]);
+            std::string scratch = solve(puzzle, opt, constructedStatistics);
+            constructed.push_back(timer.stop());
+            if (scratch != clone)
+                std::cerr << "Different solutions for " << lines[l] << std::endl;
+        }
+    }
+    delete shared;
+
+    std::cout << "Latency: " << cloned.size() << " puzzles, " << invalid << " invalid" << std::endl;
+    if (cloned.empty())
+        return;
+    const char *name[] = {"construct:", "clone:    "};
+    std::vector<double> *latencies[] = {&constructed, &cloned};
+    const Search::Statistics *statistics[] = {&constructedStatistics, &clonedStatistics};
+    for (int k = 0; k < 2; k++) {
+        std::vector<double> &l = *latencies[k];
+        double sum = 0;
+        for (size_t i = 0; i < l.size(); i++)
+            sum += l[i];
+        std::sort(l.begin(), l.end());
+        std::cout << "\t" << name[k] << "   mean " << 1000.0 * sum / l.size() << " us, median "
+                  << 1000.0 * l[l.size() / 2] << " us, p99 " << 1000.0 * l[(l.size() * 99) / 100] << " us, nodes "
+                  << statistics[k]->node << ", failures " << statistics[k]->fail << std::endl;
+    }
+}
+
 /**
  * Program entrypoint, parses commandline options and initializes search engine with root-node.
  *
@@ -345,12 +889,24 @@ int main(int argc, char *argv[]) {
     opt.solutions(1);
     opt.mode(ScriptMode::SM_SOLUTION);
     opt.ipl(IPL_DEF);
+    opt.propagation(Sudoku::PROP_DISTINCT);
+    opt.propagation(Sudoku::PROP_DISTINCT, "distinct", "distinct constraints with -ipl");
+    opt.propagation(Sudoku::PROP_BITSET, "bitset", "all-different over 64-bit masks with hidden singles and naked pairs");
 
     //parse cmd (potentially overwrite default options)
     opt.parse(argc, argv);
+    if (opt.order() < 2 || opt.order() > 7) {
+        std::cerr << "Order must be in [2,7]" << std::endl;
+        return 1;
+    }
 
-    //run script with DFS engine
-    Script::run<Sudoku, DFS, SudokuOptions>(opt);
+    //solve the puzzles of -batch on a pool of workers, or a single script with DFS engine
+    if (opt.batch() != NULL && opt.latency())
+        latency(opt);
+    else if (opt.batch() != NULL)
+        batch(opt);
+    else
+        Script::run<Sudoku, DFS, SudokuOptions>(opt);
 
     /**
      * Example cmd to solve sudoku number 0 with different options, for more options see Gecode.org:
@@ -358,6 +914,12 @@ int main(int argc, char *argv[]) {
      * ./bin/sudoku -sudoku 0 -mode solution -ipl speed
      * ./bin/sudoku -sudoku 0 -mode time -ipl def
      * ./bin/sudoku -sudoku 0 -mode stat -ipl memory
+     * ./bin/sudoku -sudoku 0 -mode stat -threads 0 -c_d 16
+     * ./bin/sudoku -batch puzzles.txt -threads 0 > solutions.txt
+     * cat puzzles.txt | ./bin/sudoku -batch - -threads 4 > solutions.txt
+     * ./bin/sudoku -batch puzzles.txt -latency
+     * ./bin/sudoku -order 4 -propagation bitset
+     * ./bin/sudoku -order 5 -propagation bitset -batch puzzles25.txt
      *
      * or with default (0, solution, def):
      * ./bin/sudoku